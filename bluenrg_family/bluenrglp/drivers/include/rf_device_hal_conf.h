@@ -61,7 +61,9 @@
 /*#define HAL_LCD_MODULE_ENABLED   */
 /*#define HAL_LPTIM_MODULE_ENABLED   */
 /*#define HAL_PCD_MODULE_ENABLED   */
-/*#define HAL_PKA_MODULE_ENABLED   */
+#if defined(CONFIG_BLUENRG_LP_HAL_PKA)
+#define HAL_PKA_MODULE_ENABLED
+#endif
 /*#define HAL_QSPI_MODULE_ENABLED   */
 /*#define HAL_RNG_MODULE_ENABLED   */
 /*#define HAL_RTC_MODULE_ENABLED   */
@@ -252,10 +254,10 @@
 #endif /* HAL_PCD_MODULE_ENABLED */
 
 #ifdef HAL_PKA_MODULE_ENABLED
-#if defined(CONFIG_DEVICE_BLUENRG_LP)
+/* The software PKA implements the BlueNRG-LP API */
+#if defined(CONFIG_DEVICE_BLUENRG_LP) || defined(CONFIG_BLUENRG_LP_HAL_PKA_SOFTWARE)
   #include "rf_driver_hal_pka_v7b.h"
-#endif  
-#if defined(CONFIG_DEVICE_BLUENRG_LPS)
+#elif defined(CONFIG_DEVICE_BLUENRG_LPS)
   #include "rf_driver_hal_pka_v7c.h"
 #endif
 #endif /* HAL_PKA_MODULE_ENABLED */ 
@@ -63,6 +63,15 @@ typedef enum
 #define HAL_IS_BIT_SET(REG, BIT)         (((REG) & (BIT)) == (BIT))
 #define HAL_IS_BIT_CLR(REG, BIT)         (((REG) & (BIT)) == 0U)
 
+/** @brief Disable the interrupts until ATOMIC_SECTION_END(), which restores the previous PRIMASK.
+  *        ATOMIC_SECTION_END() must be called in the same or in a lower scope of ATOMIC_SECTION_BEGIN().
+  */
+#ifndef ATOMIC_SECTION_BEGIN
+#define ATOMIC_SECTION_BEGIN() uint32_t uwPRIMASK_Bit = __get_PRIMASK(); \
+                                __disable_irq();
+#define ATOMIC_SECTION_END() __set_PRIMASK(uwPRIMASK_Bit)
+#endif /* ATOMIC_SECTION_BEGIN */
+
 #define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__)               \
                         do{                                                      \
                               (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__); \
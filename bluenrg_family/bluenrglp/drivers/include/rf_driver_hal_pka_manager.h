@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_pka_manager.h
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP PKA manager APIs
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#ifndef RF_DRIVER_HAL_PKA_MANAGER_H
+#define RF_DRIVER_HAL_PKA_MANAGER_H
+
+#include "rf_driver_hal.h"
+#include "rf_driver_hal_power_manager.h"
+
+#if defined(PKA) && defined(HAL_PKA_MODULE_ENABLED)
+
+/* Maximum number of requests waiting for the PKA, the running one included */
+#ifndef PKAMGR_QUEUE_SIZE
+#define PKAMGR_QUEUE_SIZE (4U)
+#endif
+
+typedef enum {
+  PKAMGR_SUCCESS = 0,
+  PKAMGR_ERR_BUSY,        /* The request queue is full, or the PKA is in use */
+  PKAMGR_ERR_PARAM,       /* Invalid parameter */
+  PKAMGR_ERR_PROCESS      /* The PKA reported an error, e.g. the point is not on the curve */
+} PKAMGR_ResultStatus;
+
+/* Called in the PKA interrupt when the operation of a request completes.
+   result: X and Y coordinates of the point computed (16 words, least significant word first),
+   only valid during the call and if status is PKAMGR_SUCCESS. */
+typedef void (*PKAMGR_funcCB)(PKAMGR_ResultStatus status, uint32_t *result);
+
+PKAMGR_ResultStatus PKAMGR_Init(void);
+
+PKAMGR_ResultStatus PKAMGR_Deinit(void);
+
+PKAMGR_ResultStatus PKAMGR_StartP256PublicKeyGeneration(const uint32_t *privateKey, PKAMGR_funcCB funcCB);
+
+PKAMGR_ResultStatus PKAMGR_StartP256DHkeyGeneration(const uint32_t *secretKey, const uint32_t *publicKey, PKAMGR_funcCB funcCB);
+
+PKAMGR_ResultStatus PKAMGR_Lock(void);
+
+PKAMGR_ResultStatus PKAMGR_Unlock(void);
+
+PKA_HandleTypeDef *PKAMGR_GetHandle(void);
+
+uint8_t PKAMGR_PowerSaveLevelCheck(uint8_t level);
+
+void PKAMGR_IRQHandler(void);
+
+#endif /* defined(PKA) && defined(HAL_PKA_MODULE_ENABLED) */
+
+#endif /* RF_DRIVER_HAL_PKA_MANAGER_H */
@@ -93,7 +93,54 @@ typedef enum
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
 #define HAL_PKA_ERROR_INVALID_CALLBACK  (0x00000080U)    /*!< Invalid Callback error */
 #endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+#define HAL_PKA_ERROR_ABORTED   (0x00000100U)    /*!< Job removed from the queue by HAL_PKA_Abort() or HAL_PKA_DeInit() */
 
+/**
+  * @}
+  */
+
+/** @defgroup PKA_Job_Queue_definition PKA job queue definition
+  * @brief  Point multiplications that can be queued with HAL_PKA_Enqueue()
+  * @{
+  */
+
+/**
+  * @brief  PKA job. The application fills K, Point, Result and Callback,
+  *         the other fields are managed by the driver. The job and its buffers must
+  *         remain valid until the job is completed.
+  */
+typedef struct __PKA_JobTypeDef
+{
+  uint32_t                      *K;                     /*!< Scalar, 8 words */
+  uint32_t                      *Point;                 /*!< Point X then Y coordinates, 16 words, NULL for the curve generator */
+  uint32_t                      *Result;                /*!< Result X then Y coordinates, 16 words, NULL if not needed */
+  void (* Callback)(struct __PKA_JobTypeDef *job);      /*!< Called when the job is completed, NULL if not needed */
+  uint32_t                      ErrorCode;              /*!< PKA Error code of the job */
+  __IO uint32_t                 Pending;                /*!< Set while the job is in the queue */
+  uint32_t                      EnqueueTick;            /*!< Tick of the call to HAL_PKA_Enqueue() */
+  uint32_t                      StartTick;              /*!< Tick of the start of the operation */
+  struct __PKA_JobTypeDef       *Next;                  /*!< Next job of the queue */
+} PKA_JobTypeDef;
+
+/**
+  * @brief  Counters of the jobs completed. Times are in HAL ticks.
+  */
+typedef struct
+{
+  uint32_t                      Count;                  /*!< Jobs completed */
+  uint32_t                      Errors;                 /*!< Jobs completed with an error */
+  uint32_t                      TotalTime;              /*!< Sum of the execution times */
+  uint32_t                      MaxTime;                /*!< Longest execution time */
+  uint32_t                      TotalLatency;           /*!< Sum of the times from HAL_PKA_Enqueue() to completion */
+  uint32_t                      MaxLatency;             /*!< Longest time from HAL_PKA_Enqueue() to completion */
+} PKA_JobStatsTypeDef;
+
+typedef struct
+{
+  uint32_t                      Depth;                  /*!< Jobs in the queue, the job in progress included */
+  uint32_t                      MaxDepth;               /*!< Highest depth since the last HAL_PKA_ResetQueueStats() */
+  PKA_JobStatsTypeDef           Jobs;                   /*!< Counters of the completed jobs */
+} PKA_QueueStatsTypeDef;
 /**
   * @}
   */
@@ -107,6 +154,10 @@ typedef struct __PKA_HandleTypeDef
   PKA_TypeDef                   *Instance;              /*!< Register base address */
   __IO HAL_PKA_StateTypeDef     State;                  /*!< PKA state */
   __IO uint32_t                 ErrorCode;              /*!< PKA Error code */
+  PKA_JobTypeDef                *JobHead;               /*!< Oldest job of the queue, in progress when JobRunning is set */
+  PKA_JobTypeDef                *JobTail;               /*!< Newest job of the queue */
+  __IO uint32_t                 JobRunning;             /*!< Set while the operation in progress is the job at the head of the queue */
+  PKA_QueueStatsTypeDef         QueueStats;             /*!< Job queue counters */
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
   void (* OperationCpltCallback)(struct __PKA_HandleTypeDef *hpka); /*!< PKA End of operation callback */
   void (* ErrorCallback)(struct __PKA_HandleTypeDef *hpka);         /*!< PKA Error callback            */
@@ -138,6 +189,16 @@ typedef  void (*pPKA_CallbackTypeDef)(PKA_HandleTypeDef *hpka); /*!< Pointer to
   * @{
   */
 
+/**
+ * @brief  Implement the PKA HAL by software (rf_driver_hal_pka_sw.c) instead of the
+ *         PKA. Intended to run the users of the PKA off-target.
+ */
+#if defined(CONFIG_BLUENRG_LP_HAL_PKA_SOFTWARE)
+#define HAL_PKA_SOFTWARE_ENABLE (1)
+#else
+#define HAL_PKA_SOFTWARE_ENABLE (0)
+#endif
+
 /** @defgroup PKA_SELECT_DATA_VALUE Select Data for PKA operation
   * @{
   */
@@ -333,6 +394,12 @@ void HAL_PKA_RAMReset(PKA_HandleTypeDef *hpka);
 void HAL_PKA_OperationCpltCallback(PKA_HandleTypeDef *hpka);
 void HAL_PKA_ErrorCallback(PKA_HandleTypeDef *hpka);
 void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka);
+
+/* Job queue functions ********************************************************/
+HAL_StatusTypeDef HAL_PKA_Enqueue(PKA_HandleTypeDef *hpka, PKA_JobTypeDef *job);
+uint32_t HAL_PKA_GetQueueDepth(PKA_HandleTypeDef *hpka);
+void HAL_PKA_GetQueueStats(PKA_HandleTypeDef *hpka, PKA_QueueStatsTypeDef *stats);
+void HAL_PKA_ResetQueueStats(PKA_HandleTypeDef *hpka);
 /**
   * @}
   */
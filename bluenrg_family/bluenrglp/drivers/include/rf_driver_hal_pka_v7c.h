@@ -91,7 +91,76 @@ typedef enum
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
 #define HAL_PKA_ERROR_INVALID_CALLBACK  (0x00000010U)    /*!< Invalid Callback error */
 #endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+#define HAL_PKA_ERROR_ABORTED   (0x00000020U)    /*!< Queued job dropped by HAL_PKA_Abort() or HAL_PKA_DeInit() */
 
+/**
+  * @}
+  */
+
+/** @defgroup PKA_Job_Queue_definition PKA job queue definition
+  * @brief  Operations that can be queued with HAL_PKA_Enqueue()
+  * @{
+  */
+typedef enum
+{
+  HAL_PKA_JOB_MODULAR_EXP           = 0x00U,  /*!< In: PKA_ModExpInTypeDef, Out: uint8_t result buffer               */
+  HAL_PKA_JOB_MODULAR_EXP_FAST_MODE = 0x01U,  /*!< In: PKA_ModExpFastModeInTypeDef, Out: uint8_t result buffer       */
+  HAL_PKA_JOB_ECDSA_SIGNATURE       = 0x02U,  /*!< In: PKA_ECDSASignInTypeDef, Out: PKA_ECDSASignOutTypeDef,
+                                                   OutExt: PKA_ECDSASignOutExtParamTypeDef                            */
+  HAL_PKA_JOB_ECDSA_VERIFICATION    = 0x03U,  /*!< In: PKA_ECDSAVerifInTypeDef, result in the Result field          */
+  HAL_PKA_JOB_RSA_CRT_EXP           = 0x04U,  /*!< In: PKA_RSACRTExpInTypeDef, Out: uint8_t result buffer            */
+  HAL_PKA_JOB_POINT_CHECK           = 0x05U,  /*!< In: PKA_PointCheckInTypeDef, result in the Result field          */
+  HAL_PKA_JOB_ECC_MUL               = 0x06U,  /*!< In: PKA_ECCMulInTypeDef, Out: PKA_ECCMulOutTypeDef                */
+  HAL_PKA_JOB_ECC_MUL_FAST_MODE     = 0x07U,  /*!< In: PKA_ECCMulFastModeInTypeDef, Out: PKA_ECCMulOutTypeDef        */
+  HAL_PKA_JOB_MONTGOMERY_PARAM      = 0x08U,  /*!< In: PKA_MontgomeryParamInTypeDef, Out: uint32_t result buffer     */
+  HAL_PKA_JOB_MODULAR_EXP_CTX       = 0x09U,  /*!< In: PKA_ModExpCtxInTypeDef, Out: uint8_t result buffer            */
+  HAL_PKA_JOB_ECDSA_SIGNATURE_CTX   = 0x0AU,  /*!< In: PKA_ECDSASignCtxInTypeDef, Out: PKA_ECDSASignOutTypeDef,
+                                                   OutExt: PKA_ECDSASignOutExtParamTypeDef                            */
+  HAL_PKA_JOB_ECDSA_VERIFICATION_CTX = 0x0BU, /*!< In: PKA_ECDSAVerifCtxInTypeDef, result in the Result field       */
+  HAL_PKA_JOB_ECC_MUL_CTX           = 0x0CU,  /*!< In: PKA_ECCMulCtxInTypeDef, Out: PKA_ECCMulOutTypeDef             */
+} HAL_PKA_JobOperationTypeDef;
+
+#define HAL_PKA_JOB_OPERATION_NUMBER  13U
+
+/**
+  * @brief  PKA job. The application fills Operation, In, Out, OutExt and Callback,
+  *         the other fields are managed by the driver. The job and its buffers must
+  *         remain valid until the job is completed.
+  */
+typedef struct __PKA_JobTypeDef
+{
+  HAL_PKA_JobOperationTypeDef   Operation;              /*!< Operation to run */
+  void                          *In;                    /*!< Input information of the operation */
+  void                          *Out;                   /*!< Output buffer or structure, NULL if not needed */
+  void                          *OutExt;                /*!< Additional output of the ECDSA signature, NULL if not needed */
+  void (* Callback)(struct __PKA_JobTypeDef *job);      /*!< Called by HAL_PKA_IRQHandler() when the job is completed, NULL if not needed */
+  uint32_t                      ErrorCode;              /*!< PKA Error code of the job */
+  uint32_t                      Result;                 /*!< 1 if the signature is valid or the point is on the curve, 0 in other case */
+  __IO uint32_t                 Pending;                /*!< Set while the job is in the queue */
+  uint32_t                      EnqueueTick;            /*!< Tick of the call to HAL_PKA_Enqueue() */
+  uint32_t                      StartTick;              /*!< Tick of the start of the operation */
+  struct __PKA_JobTypeDef       *Next;                  /*!< Next job of the queue */
+} PKA_JobTypeDef;
+
+/**
+  * @brief  Counters of the jobs completed for one operation. Times are in HAL ticks.
+  */
+typedef struct
+{
+  uint32_t                      Count;                  /*!< Jobs completed */
+  uint32_t                      Errors;                 /*!< Jobs completed with an error */
+  uint32_t                      TotalTime;              /*!< Sum of the execution times */
+  uint32_t                      MaxTime;                /*!< Longest execution time */
+  uint32_t                      TotalLatency;           /*!< Sum of the times from HAL_PKA_Enqueue() to completion */
+  uint32_t                      MaxLatency;             /*!< Longest time from HAL_PKA_Enqueue() to completion */
+} PKA_JobStatsTypeDef;
+
+typedef struct
+{
+  uint32_t                      Depth;                  /*!< Jobs in the queue, the job in progress included */
+  uint32_t                      MaxDepth;               /*!< Highest depth since the last HAL_PKA_ResetQueueStats() */
+  PKA_JobStatsTypeDef           Operation[HAL_PKA_JOB_OPERATION_NUMBER]; /*!< Counters indexed by HAL_PKA_JobOperationTypeDef */
+} PKA_QueueStatsTypeDef;
 /**
   * @}
   */
@@ -109,6 +178,10 @@ typedef struct
   PKA_TypeDef                   *Instance;              /*!< Register base address */
   __IO HAL_PKA_StateTypeDef     State;                  /*!< PKA state */
   __IO uint32_t                 ErrorCode;              /*!< PKA Error code */
+  PKA_JobTypeDef                *JobHead;               /*!< Oldest job of the queue, in progress when JobRunning is set */
+  PKA_JobTypeDef                *JobTail;               /*!< Newest job of the queue */
+  __IO uint32_t                 JobRunning;             /*!< Set while the operation in progress is the job at the head of the queue */
+  PKA_QueueStatsTypeDef         QueueStats;             /*!< Job queue counters */
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
   void (* OperationCpltCallback)(struct __PKA_HandleTypeDef *hpka); /*!< PKA End of operation callback */
   void (* ErrorCallback)(struct __PKA_HandleTypeDef *hpka);         /*!< PKA Error callback            */
@@ -282,6 +355,113 @@ typedef struct
   const uint8_t  *pOp3;                /*!< Pointer to Operand 3 (Array of size*4 elements) */
 } PKA_ModAddInTypeDef, PKA_ModSubInTypeDef, PKA_MontgomeryMulInTypeDef;
 
+/**
+  * @}
+  */
+
+/** @defgroup PKA_Context PKA curve and modulus context definition
+  * @brief  Curve and modulus parameters converted once to the PKA RAM representation,
+  *         with their Montgomery parameter, and the operations using them
+  * @{
+  */
+#ifndef HAL_PKA_CURVE_MAX_SIZE
+#define HAL_PKA_CURVE_MAX_SIZE     32U     /*!< Largest modulus and order of a curve context in bytes (P-256) */
+#endif /* HAL_PKA_CURVE_MAX_SIZE */
+#ifndef HAL_PKA_MODULUS_MAX_SIZE
+#define HAL_PKA_MODULUS_MAX_SIZE   256U    /*!< Largest modulus of a modulus context in bytes (2048 bits) */
+#endif /* HAL_PKA_MODULUS_MAX_SIZE */
+
+#define HAL_PKA_CURVE_MAX_WORDS    ((HAL_PKA_CURVE_MAX_SIZE + 3U) / 4U)
+#define HAL_PKA_MODULUS_MAX_WORDS  ((HAL_PKA_MODULUS_MAX_SIZE + 3U) / 4U)
+
+typedef struct
+{
+  uint32_t primeOrderSize;             /*!< Number of element in primeOrder array */
+  uint32_t modulusSize;                /*!< Number of element in coef, modulus, basePointX and basePointY arrays */
+  uint32_t coefSign;                   /*!< Curve coefficient a sign */
+  const uint8_t *coef;                 /*!< Pointer to curve coefficient |a|     (Array of modulusSize elements) */
+  const uint8_t *modulus;              /*!< Pointer to curve modulus value p     (Array of modulusSize elements) */
+  const uint8_t *basePointX;           /*!< Pointer to curve base point xG       (Array of modulusSize elements) */
+  const uint8_t *basePointY;           /*!< Pointer to curve base point yG       (Array of modulusSize elements) */
+  const uint8_t *primeOrder;           /*!< Pointer to order of the curve n      (Array of primeOrderSize elements) */
+} PKA_CurveInTypeDef;
+
+/* Curve context filled by HAL_PKA_CurveInit(). The fields must not be modified by the application. */
+typedef struct
+{
+  uint32_t primeOrderSize;             /*!< Size of the order in bytes */
+  uint32_t modulusSize;                /*!< Size of the modulus in bytes */
+  uint32_t primeOrderNbBits;           /*!< Number of bits of the order */
+  uint32_t modulusNbBits;              /*!< Number of bits of the modulus */
+  uint32_t coefSign;                   /*!< Curve coefficient a sign */
+  uint32_t coef[HAL_PKA_CURVE_MAX_WORDS];            /*!< Curve coefficient |a| in PKA RAM representation */
+  uint32_t modulus[HAL_PKA_CURVE_MAX_WORDS];         /*!< Curve modulus p in PKA RAM representation */
+  uint32_t basePointX[HAL_PKA_CURVE_MAX_WORDS];      /*!< Base point xG in PKA RAM representation */
+  uint32_t basePointY[HAL_PKA_CURVE_MAX_WORDS];      /*!< Base point yG in PKA RAM representation */
+  uint32_t primeOrder[HAL_PKA_CURVE_MAX_WORDS];      /*!< Order n in PKA RAM representation */
+  uint32_t montgomeryParam[HAL_PKA_CURVE_MAX_WORDS]; /*!< Montgomery parameter of the modulus */
+} PKA_CurveTypeDef;
+
+/* Modulus context filled by HAL_PKA_ModulusInit(). The fields must not be modified by the application. */
+typedef struct
+{
+  uint32_t OpSize;                     /*!< Size of the modulus in bytes */
+  uint32_t modulus[HAL_PKA_MODULUS_MAX_WORDS];         /*!< Modulus in PKA RAM representation */
+  uint32_t montgomeryParam[HAL_PKA_MODULUS_MAX_WORDS]; /*!< Montgomery parameter of the modulus */
+} PKA_ModulusTypeDef;
+
+typedef struct
+{
+  const PKA_ModulusTypeDef *modulus;   /*!< Modulus context */
+  uint32_t expSize;                    /*!< Number of element in pExp array */
+  const uint8_t *pExp;                 /*!< Pointer to Exponent             (Array of expSize elements) */
+  const uint8_t *pOp1;                 /*!< Pointer to Operand              (Array of modulus->OpSize elements) */
+} PKA_ModExpCtxInTypeDef;
+
+typedef struct
+{
+  const PKA_CurveTypeDef *curve;       /*!< Curve context */
+  const uint8_t *integer;              /*!< Pointer to random integer k          (Array of curve->primeOrderSize elements) */
+  const uint8_t *hash;                 /*!< Pointer to hash of the message       (Array of curve->primeOrderSize elements) */
+  const uint8_t *privateKey;           /*!< Pointer to private key d             (Array of curve->primeOrderSize elements) */
+} PKA_ECDSASignCtxInTypeDef;
+
+typedef struct
+{
+  const PKA_CurveTypeDef *curve;       /*!< Curve context */
+  const uint8_t *pPubKeyCurvePtX;      /*!< Pointer to public-key curve point xQ (Array of curve->modulusSize elements) */
+  const uint8_t *pPubKeyCurvePtY;      /*!< Pointer to public-key curve point yQ (Array of curve->modulusSize elements) */
+  const uint8_t *RSign;                /*!< Pointer to signature part r          (Array of curve->primeOrderSize elements) */
+  const uint8_t *SSign;                /*!< Pointer to signature part s          (Array of curve->primeOrderSize elements) */
+  const uint8_t *hash;                 /*!< Pointer to hash of the message e     (Array of curve->primeOrderSize elements) */
+} PKA_ECDSAVerifCtxInTypeDef;
+
+typedef struct
+{
+  const PKA_CurveTypeDef *curve;       /*!< Curve context */
+  uint32_t scalarMulSize;              /*!< Number of element in scalarMul array */
+  const uint8_t *scalarMul;            /*!< Pointer to scalar multiplier k       (Array of scalarMulSize elements) */
+  const uint8_t *pointX;               /*!< Pointer to point P coordinate xP     (Array of curve->modulusSize elements) */
+  const uint8_t *pointY;               /*!< Pointer to point P coordinate yP     (Array of curve->modulusSize elements) */
+} PKA_ECCMulCtxInTypeDef;
+
+typedef struct
+{
+  const uint8_t *RSign;                /*!< Pointer to signature part r          (Array of curve->primeOrderSize elements) */
+  const uint8_t *SSign;                /*!< Pointer to signature part s          (Array of curve->primeOrderSize elements) */
+  const uint8_t *hash;                 /*!< Pointer to hash of the message e     (Array of curve->primeOrderSize elements) */
+  uint32_t keyIndex;                   /*!< Index of the public key in pPubKeyCurvePtX and pPubKeyCurvePtY */
+} PKA_ECDSAVerifBatchItemTypeDef;
+
+typedef struct
+{
+  const PKA_CurveTypeDef *curve;       /*!< Curve context */
+  uint32_t keyNumber;                  /*!< Number of public keys */
+  const uint8_t *const *pPubKeyCurvePtX; /*!< Pointers to public-key curve point xQ (Array of keyNumber elements) */
+  const uint8_t *const *pPubKeyCurvePtY; /*!< Pointers to public-key curve point yQ (Array of keyNumber elements) */
+  uint32_t itemNumber;                 /*!< Number of signatures to verify */
+  const PKA_ECDSAVerifBatchItemTypeDef *items; /*!< Signatures to verify (Array of itemNumber elements) */
+} PKA_ECDSAVerifBatchInTypeDef;
 /**
   * @}
   */
@@ -549,12 +729,32 @@ HAL_StatusTypeDef HAL_PKA_MontgomeryParam(PKA_HandleTypeDef *hpka, PKA_Montgomer
 HAL_StatusTypeDef HAL_PKA_MontgomeryParam_IT(PKA_HandleTypeDef *hpka, PKA_MontgomeryParamInTypeDef *in);
 void HAL_PKA_MontgomeryParam_GetResult(PKA_HandleTypeDef *hpka, uint32_t *pRes);
 
+/* Curve and modulus context functions ****************************************/
+HAL_StatusTypeDef HAL_PKA_CurveInit(PKA_HandleTypeDef *hpka, PKA_CurveTypeDef *curve, PKA_CurveInTypeDef *in, uint32_t Timeout);
+HAL_StatusTypeDef HAL_PKA_ModulusInit(PKA_HandleTypeDef *hpka, PKA_ModulusTypeDef *modulus, const uint8_t *pMod, uint32_t OpSize, uint32_t Timeout);
+
+HAL_StatusTypeDef HAL_PKA_ModExpCtx(PKA_HandleTypeDef *hpka, PKA_ModExpCtxInTypeDef *in, uint32_t Timeout);
+HAL_StatusTypeDef HAL_PKA_ModExpCtx_IT(PKA_HandleTypeDef *hpka, PKA_ModExpCtxInTypeDef *in);
+HAL_StatusTypeDef HAL_PKA_ECDSASignCtx(PKA_HandleTypeDef *hpka, PKA_ECDSASignCtxInTypeDef *in, uint32_t Timeout);
+HAL_StatusTypeDef HAL_PKA_ECDSASignCtx_IT(PKA_HandleTypeDef *hpka, PKA_ECDSASignCtxInTypeDef *in);
+HAL_StatusTypeDef HAL_PKA_ECDSAVerifCtx(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifCtxInTypeDef *in, uint32_t Timeout);
+HAL_StatusTypeDef HAL_PKA_ECDSAVerifCtx_IT(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifCtxInTypeDef *in);
+HAL_StatusTypeDef HAL_PKA_ECCMulCtx(PKA_HandleTypeDef *hpka, PKA_ECCMulCtxInTypeDef *in, uint32_t Timeout);
+HAL_StatusTypeDef HAL_PKA_ECCMulCtx_IT(PKA_HandleTypeDef *hpka, PKA_ECCMulCtxInTypeDef *in);
+HAL_StatusTypeDef HAL_PKA_ECDSAVerifBatch(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifBatchInTypeDef *in, uint32_t *validity, uint32_t Timeout);
+
 
 HAL_StatusTypeDef HAL_PKA_Abort(PKA_HandleTypeDef *hpka);
 void HAL_PKA_RAMReset(PKA_HandleTypeDef *hpka);
 void HAL_PKA_OperationCpltCallback(PKA_HandleTypeDef *hpka);
 void HAL_PKA_ErrorCallback(PKA_HandleTypeDef *hpka);
 void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka);
+
+/* Job queue functions ********************************************************/
+HAL_StatusTypeDef HAL_PKA_Enqueue(PKA_HandleTypeDef *hpka, PKA_JobTypeDef *job);
+uint32_t HAL_PKA_GetQueueDepth(PKA_HandleTypeDef *hpka);
+void HAL_PKA_GetQueueStats(PKA_HandleTypeDef *hpka, PKA_QueueStatsTypeDef *stats);
+void HAL_PKA_ResetQueueStats(PKA_HandleTypeDef *hpka);
 /**
   * @}
   */
@@ -20,6 +20,65 @@
 #define RF_DRIVER_HAL_RADIO_H
 
 #include "rf_driver_ll_radio_2g4.h"
+#include "fifo.h"
+
+/* Number of ActionPackets in the burst TX ring. The buffers of a longer burst
+   are loaded in the ring packets as they are released by the radio. */
+#ifndef HAL_RADIO_BURST_RING_SIZE
+#define HAL_RADIO_BURST_RING_SIZE (4U)
+#endif
+
+typedef struct {
+  uint16_t PacketCount; /* Number of packets of the burst */
+  uint16_t PacketsSent; /* Number of packets transmitted so far */
+  uint32_t StartTime;   /* Time of the first transmission, in STU */
+  uint32_t EndTime;     /* Time of the end of the last transmission, in STU. Valid when the burst is completed */
+  uint8_t Active;       /* TRUE while the burst is running */
+} HAL_RADIO_BurstStatusType;
+
+/* Header stored in the FIFO before each packet received in streaming mode.
+   It is followed by the packet: header, length and data field. */
+typedef struct {
+  uint32_t timestamp_receive; /* Time stamp of the packet, in STU */
+  int8_t rssi;                /* RSSI of the packet, in dBm */
+  uint8_t reserved[3];
+} HAL_RADIO_StreamItemHeaderType;
+
+typedef struct {
+  uint32_t PacketsReceived; /* Packets received without CRC error and stored in the FIFO */
+  uint32_t PacketsDropped;  /* Packets received without CRC error but lost because the FIFO was full */
+  uint32_t CrcErrors;       /* Packets received with CRC error */
+  uint32_t Timeouts;        /* RX windows ended without any packet */
+  uint8_t Active;           /* TRUE while the streaming is running */
+} HAL_RADIO_StreamStatusType;
+
+/* Number of actions that can be queued on a link for one radio activity */
+#ifndef HAL_RADIO_LINK_QUEUE_SIZE
+#define HAL_RADIO_LINK_QUEUE_SIZE (2U)
+#endif
+
+/* Default coefficients of the RSSI filter of a link, see RADIO_RSSIFilterInit() */
+#ifndef HAL_RADIO_LINK_RSSI_ATTACK_COEFF
+#define HAL_RADIO_LINK_RSSI_ATTACK_COEFF (2U)
+#endif
+#ifndef HAL_RADIO_LINK_RSSI_DECAY_COEFF
+#define HAL_RADIO_LINK_RSSI_DECAY_COEFF (3U)
+#endif
+
+/* Context of a link using its own state machine (1 to 7).
+   The state machine 0 is left to the single link APIs (HAL_RADIO_SendPacket(), ...).
+   The fields must not be modified directly by the application. */
+typedef struct {
+  uint32_t NetworkID;
+  uint32_t CrcInit;
+  uint8_t Channel;
+  uint8_t ChannelMap[5];
+  uint8_t StateMachineNo;
+  uint8_t ActionCount;  /* Number of actions queued for the next HAL_RADIO_LinkSchedule() */
+  ActionPacket actionPacket[HAL_RADIO_LINK_QUEUE_SIZE];
+  uint8_t (*callback[HAL_RADIO_LINK_QUEUE_SIZE])(ActionPacket*, ActionPacket*);
+  RSSIFilter_t RssiFilter;  /* Average RSSI of the packets received on the link */
+} HAL_RADIO_LinkType;
 
 uint8_t HAL_RADIO_SendPacket(uint8_t channel, 
                     uint32_t wakeup_time, 
@@ -49,8 +108,56 @@ uint8_t HAL_RADIO_ReceivePacketWithAck(uint8_t channel,
                              uint8_t receive_length, 
                              uint8_t (*Callback)(ActionPacket*, ActionPacket*));
                         
+uint8_t HAL_RADIO_SendPacketBurst(uint8_t channel,
+                                  uint32_t wakeup_time,
+                                  uint32_t back_to_back_time,
+                                  uint8_t** txBuffers,
+                                  uint16_t count,
+                                  uint8_t (*Callback)(ActionPacket*, ActionPacket*));
+
+void HAL_RADIO_GetBurstStatus(HAL_RADIO_BurstStatusType *status);
+
+uint8_t HAL_RADIO_StartReceiveStream(uint8_t channel,
+                                     uint32_t wakeup_time,
+                                     uint32_t receive_timeout,
+                                     uint8_t receive_length,
+                                     circular_fifo_spsc_t *fifo);
+
+void HAL_RADIO_StopReceiveStream(void);
+
+void HAL_RADIO_GetStreamStatus(HAL_RADIO_StreamStatusType *status);
+
+uint8_t HAL_RADIO_LinkOpen(HAL_RADIO_LinkType *link, uint8_t channel, uint32_t networkID, uint32_t crc_init);
+
+void HAL_RADIO_LinkClose(HAL_RADIO_LinkType *link);
+
+uint8_t HAL_RADIO_LinkSetChannel(HAL_RADIO_LinkType *link, uint8_t channel, uint8_t *chan_remap);
+
+uint8_t HAL_RADIO_LinkQueueTx(HAL_RADIO_LinkType *link,
+                              uint8_t* txBuffer,
+                              uint8_t (*Callback)(ActionPacket*, ActionPacket*));
+
+uint8_t HAL_RADIO_LinkQueueRx(HAL_RADIO_LinkType *link,
+                              uint8_t* rxBuffer,
+                              uint8_t receive_length,
+                              uint8_t (*Callback)(ActionPacket*, ActionPacket*));
+
+uint8_t HAL_RADIO_LinkSchedule(uint32_t wakeup_time, uint32_t receive_timeout);
+
+uint8_t HAL_RADIO_LinkSetRssiFilter(HAL_RADIO_LinkType *link, uint8_t attack_coeff, uint8_t decay_coeff);
+
+int8_t HAL_RADIO_LinkGetRssi(HAL_RADIO_LinkType *link);
+
 uint8_t HAL_RADIO_SetNetworkID(uint32_t ID);
 
 uint8_t HAL_RADIO_CarrierSense(uint8_t channel, int8_t *rssi);
 
+uint8_t HAL_RADIO_EnergySweep(uint8_t* channels,
+                              uint8_t count,
+                              uint8_t samples,
+                              uint32_t wakeup_time,
+                              uint32_t rx_window,
+                              int8_t* rssi,
+                              uint8_t (*Callback)(ActionPacket*, ActionPacket*));
+
 #endif /* RF_DRIVER_HAL_RADIO_H */
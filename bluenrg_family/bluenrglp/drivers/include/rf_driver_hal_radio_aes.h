@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_radio_aes.h
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP HAL AES CTR and CCM modes on the manual AES unit of the radio
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#ifndef RF_DRIVER_HAL_RADIO_AES_H
+#define RF_DRIVER_HAL_RADIO_AES_H
+
+#include "rf_driver_ll_radio_2g4.h"
+
+/**
+ * @brief  Encrypt the blocks by software instead of the manual AES unit of the radio.
+ *         Intended to run the AES modes off-target and to compare their throughput.
+ */
+#if defined(CONFIG_BLUENRG_LP_HAL_RADIO_AES_SOFTWARE)
+#define HAL_RADIO_AES_SOFTWARE_ENABLE (1)
+#else
+#define HAL_RADIO_AES_SOFTWARE_ENABLE (0)
+#endif
+
+#define HAL_RADIO_AES_BLOCK_SIZE      (16U)
+
+/* Status given to the completion callback when the tag of a CCM decryption is wrong */
+#define HAL_RADIO_AES_MIC_FAILURE_3D  (0x3DU)
+
+typedef struct HAL_RADIO_AesType HAL_RADIO_AesType;
+
+/* Context of an AES key. The fields must not be accessed directly by the application. */
+struct HAL_RADIO_AesType {
+  uint32_t key[4];          /* Key, most significant word first */
+#if HAL_RADIO_AES_SOFTWARE_ENABLE
+  uint32_t roundKey[44];
+#endif
+  void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status);
+  const uint8_t *in;
+  uint8_t *out;
+  const uint8_t *aad;
+  uint8_t *tag;
+  uint16_t length;
+  uint16_t aadLength;
+  uint32_t counter[4];      /* Next counter block */
+  uint32_t mac[4];          /* CBC-MAC of the blocks processed */
+  uint32_t s0[4];           /* Encrypted counter block 0, masks the CCM tag */
+  uint32_t next[4];         /* Input of the next block, packed while the current block is encrypted */
+  uint16_t ctrNext;         /* Counter blocks prepared */
+  uint16_t ctrDone;         /* Counter blocks processed */
+  uint16_t ctrCount;
+  uint16_t macNext;         /* CBC-MAC blocks prepared */
+  uint16_t macDone;         /* CBC-MAC blocks processed */
+  uint16_t macCount;
+  uint16_t aadBlocks;
+  uint8_t nextKind;
+  uint8_t currentKind;
+  uint8_t mode;
+  uint8_t tagLength;
+  uint8_t status;           /* Status of the last operation */
+  volatile uint8_t busy;
+};
+
+uint8_t HAL_RADIO_AesInit(HAL_RADIO_AesType *aes, const uint8_t *key);
+
+uint8_t HAL_RADIO_AesCtr(HAL_RADIO_AesType *aes,
+                         const uint8_t *counter,
+                         const uint8_t *in,
+                         uint8_t *out,
+                         uint16_t length,
+                         void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status));
+
+uint8_t HAL_RADIO_AesCcmEncrypt(HAL_RADIO_AesType *aes,
+                                const uint8_t *nonce, uint8_t nonce_length,
+                                const uint8_t *aad, uint16_t aad_length,
+                                const uint8_t *in, uint8_t *out, uint16_t length,
+                                uint8_t *tag, uint8_t tag_length,
+                                void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status));
+
+uint8_t HAL_RADIO_AesCcmDecrypt(HAL_RADIO_AesType *aes,
+                                const uint8_t *nonce, uint8_t nonce_length,
+                                const uint8_t *aad, uint16_t aad_length,
+                                const uint8_t *in, uint8_t *out, uint16_t length,
+                                uint8_t *tag, uint8_t tag_length,
+                                void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status));
+
+uint8_t HAL_RADIO_AesIsBusy(HAL_RADIO_AesType *aes);
+
+void HAL_RADIO_AesIRQHandler(void);
+
+#endif /* RF_DRIVER_HAL_RADIO_AES_H */
@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_radio_afh.h
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP HAL radio adaptive frequency hopping APIs
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#ifndef RF_DRIVER_HAL_RADIO_AFH_H
+#define RF_DRIVER_HAL_RADIO_AFH_H
+
+#include "rf_driver_hal_radio_2g4.h"
+
+/* Hopping is done on the data channels 0 to 36 */
+#define HAL_RADIO_AFH_CHANNELS (37U)
+
+typedef struct {
+  uint8_t Hop;             /* Hop increment, from 5 to 16 */
+  uint8_t MinChannels;     /* Minimum number of channels in use, at least 2 */
+  uint8_t PerThreshold;    /* Packet error rate above which a channel is excluded, in percent */
+  int8_t RssiThreshold;    /* Interference level above which a channel is excluded, in dBm */
+  uint16_t InstantOffset;  /* Events between a channel map update and its use */
+  uint8_t ExcludeUpdates;  /* Map updates during which a bad channel stays excluded, at least 1 */
+} HAL_RADIO_AfhConfigType;
+
+typedef struct {
+  uint16_t Packets;        /* Exchanges on the channel since the last map update */
+  uint16_t Errors;         /* Exchanges failed (no packet, CRC error, no acknowledgement) */
+  int16_t Interference;    /* Average RSSI measured without any valid packet, in 1/16 dBm */
+  uint8_t Excluded;        /* Map updates before an excluded channel is used again */
+} HAL_RADIO_AfhChannelStatsType;
+
+/* The fields must not be modified directly by the application */
+typedef struct {
+  HAL_RADIO_AfhConfigType config;
+  HAL_RADIO_AfhChannelStatsType stats[HAL_RADIO_AFH_CHANNELS];
+  uint8_t ChannelMap[5];   /* Channel map in use, same format as RADIO_SetChannelMap() */
+  uint8_t PendingMap[5];   /* Channel map to use from the instant */
+  uint8_t PendingValid;
+  uint16_t Instant;        /* Event counter value from which PendingMap is used */
+  uint16_t EventCounter;
+  uint8_t Channel;         /* Channel of the current event */
+  uint8_t unmappedChannel;
+  uint8_t numUsedChannels;
+  uint8_t usedChannels[HAL_RADIO_AFH_CHANNELS];
+} HAL_RADIO_AfhType;
+
+uint8_t HAL_RADIO_AfhInit(HAL_RADIO_AfhType *afh, HAL_RADIO_AfhConfigType *config, uint8_t channel);
+
+uint8_t HAL_RADIO_AfhNextChannel(HAL_RADIO_AfhType *afh);
+
+void HAL_RADIO_AfhReportRx(HAL_RADIO_AfhType *afh, ActionPacket *p);
+
+void HAL_RADIO_AfhReportTx(HAL_RADIO_AfhType *afh, uint8_t acked);
+
+uint8_t HAL_RADIO_AfhUpdateMap(HAL_RADIO_AfhType *afh, uint8_t *chan_remap, uint16_t *instant);
+
+uint8_t HAL_RADIO_AfhSetPendingMap(HAL_RADIO_AfhType *afh, uint8_t *chan_remap, uint16_t instant);
+
+#endif /* RF_DRIVER_HAL_RADIO_AFH_H */
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_radio_arq.h
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP HAL radio reliable transport (ARQ) APIs
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#ifndef RF_DRIVER_HAL_RADIO_ARQ_H
+#define RF_DRIVER_HAL_RADIO_ARQ_H
+
+#include "rf_driver_hal_radio_2g4.h"
+
+/* Maximum number of frames sent and not yet acknowledged. The selective
+   acknowledgement carries one bit for each frame of the window. */
+#define HAL_RADIO_ARQ_MAX_WINDOW (8U)
+
+/* Maximum user payload of a frame */
+#ifndef HAL_RADIO_ARQ_MAX_PAYLOAD
+#define HAL_RADIO_ARQ_MAX_PAYLOAD (64U)
+#endif
+
+/* ARQ header: frame type and sequence number */
+#define HAL_RADIO_ARQ_HEADER_LENGTH (2U)
+
+#define HAL_RADIO_ARQ_FRAME_SIZE (HEADER_LENGTH + HAL_RADIO_ARQ_HEADER_LENGTH + HAL_RADIO_ARQ_MAX_PAYLOAD)
+
+typedef struct {
+  uint8_t Channel;         /* Frequency channel between 0 to 39 */
+  uint32_t NetworkID;      /* Network ID of the link, see HAL_RADIO_SetNetworkID() */
+  uint8_t Window;          /* Number of frames in flight, from 1 to HAL_RADIO_ARQ_MAX_WINDOW */
+  uint8_t MaxRetries;      /* Transmissions of a frame before the link is declared lost */
+  uint32_t ReceiveTimeout; /* RX window in us: acknowledgement wait for the sender, listen window for the receiver */
+} HAL_RADIO_ArqConfigType;
+
+typedef struct {
+  uint32_t FramesSent;      /* Data frames transmitted, retransmissions included */
+  uint32_t Retransmissions; /* Data frames transmitted again */
+  uint32_t FramesAcked;     /* Data frames acknowledged by the receiver */
+  uint32_t FramesReceived;  /* Data frames delivered in order to the FIFO */
+  uint32_t Duplicates;      /* Data frames received again and discarded */
+  uint8_t Error;            /* TRUE if a frame has not been acknowledged after MaxRetries transmissions */
+  uint8_t Active;           /* TRUE while the radio activity is running */
+} HAL_RADIO_ArqStatusType;
+
+/* Context of an ARQ endpoint. A context is either a sender or a receiver.
+   The fields must not be accessed directly by the application. */
+typedef struct {
+  HAL_RADIO_ArqConfigType config;
+  HAL_RADIO_ArqStatusType status;
+  ActionPacket actionPacket[2];
+  uint8_t slot[HAL_RADIO_ARQ_MAX_WINDOW][HAL_RADIO_ARQ_FRAME_SIZE];
+  uint8_t slotState[HAL_RADIO_ARQ_MAX_WINDOW];
+  uint8_t slotRetries[HAL_RADIO_ARQ_MAX_WINDOW];
+  uint8_t radioBuffer[HAL_RADIO_ARQ_FRAME_SIZE]; /* Received frame (receiver) or acknowledgement (sender) */
+  uint8_t ackBuffer[HEADER_LENGTH + HAL_RADIO_ARQ_HEADER_LENGTH + 1];
+  /* Sender */
+  volatile uint8_t base;  /* Oldest frame not acknowledged */
+  volatile uint8_t tail;  /* Next sequence number to queue */
+  uint8_t txSeq;          /* Last frame transmitted */
+  /* Receiver */
+  circular_fifo_spsc_t *fifo;
+  uint8_t expected;       /* Next in-order sequence number */
+  uint16_t rxBitmap;      /* Bit i set if the frame expected+i has been received */
+  uint8_t rxStore;        /* The last frame received must be stored */
+  uint8_t rxDeliverFrom;  /* First frame to deliver to the FIFO */
+  uint8_t rxDeliver;      /* Number of frames to deliver to the FIFO */
+  volatile uint8_t stopRequest;
+} HAL_RADIO_ArqType;
+
+uint8_t HAL_RADIO_ArqInit(HAL_RADIO_ArqType *arq, HAL_RADIO_ArqConfigType *config);
+
+uint8_t HAL_RADIO_ArqSend(HAL_RADIO_ArqType *arq, uint8_t *data, uint8_t length);
+
+uint8_t HAL_RADIO_ArqStartTransmit(HAL_RADIO_ArqType *arq, uint32_t wakeup_time);
+
+uint8_t HAL_RADIO_ArqStartReceive(HAL_RADIO_ArqType *arq, uint32_t wakeup_time, circular_fifo_spsc_t *fifo);
+
+void HAL_RADIO_ArqStopReceive(HAL_RADIO_ArqType *arq);
+
+uint8_t HAL_RADIO_ArqGetFreeSlots(HAL_RADIO_ArqType *arq);
+
+void HAL_RADIO_ArqGetStatus(HAL_RADIO_ArqType *arq, HAL_RADIO_ArqStatusType *status);
+
+#endif /* RF_DRIVER_HAL_RADIO_ARQ_H */
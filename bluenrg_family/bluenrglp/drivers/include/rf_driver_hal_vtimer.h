@@ -46,13 +46,38 @@ typedef enum {
   RADIO_TIMER_PENDING = 1,
 } TimerStatus; 
 
+/**
+ * @brief Timer queue backend: 0 for the sorted linked list, 1 for the pairing heap
+ *        (O(1) start, O(log n) amortized stop and expiry).
+ */
+#if defined(CONFIG_BLUENRG_LP_VTIMER_HEAP)
+#define VTIMER_HEAP_ENABLE (1)
+#else
+#define VTIMER_HEAP_ENABLE (0)
+#endif
+
+/**
+ * @brief Callback dispatch statistics: 0 to disable, 1 to collect them (see HAL_VTIMER_GetStats()).
+ */
+#if defined(CONFIG_BLUENRG_LP_VTIMER_STATS)
+#define VTIMER_STATS_ENABLE (1)
+#else
+#define VTIMER_STATS_ENABLE (0)
+#endif
+
 typedef void (*VTIMER_CallbackType)(void *);
 typedef struct VTIMER_HandleTypeS {
 	uint64_t expiryTime; /*!< Managed internally when the timer is started */
 	VTIMER_CallbackType callback; /*!< Pointer to the user callback */
-	BOOL active; /*!< Managed internally when the timer is started */
+	BOOL active; /*!< Managed internally when the timer is started. It must be FALSE (e.g. zero-initialized handle) before the first use */
 	struct VTIMER_HandleTypeS *next; /*!< Managed internally when the timer is started */
 	void *userData; /*!< Pointer to user data */
+	uint32_t slack; /*!< Managed internally when the timer is started */
+	uint32_t period; /*!< Managed internally when the timer is started */
+#if VTIMER_HEAP_ENABLE
+	struct VTIMER_HandleTypeS *child; /*!< Managed internally when the timer is started */
+	struct VTIMER_HandleTypeS *prev; /*!< Managed internally when the timer is started */
+#endif
 } VTIMER_HandleType;
 
 typedef struct HAL_VTIMER_InitS {
@@ -65,6 +90,42 @@ typedef struct HAL_VTIMER_InitS {
   uint32_t PeriodicCalibrationInterval;  /*!< Periodic calibration interval in ms, to disable set to 0 */
 } HAL_VTIMER_InitType;
 
+typedef struct HAL_VTIMER_AdaptiveCalibrationS {
+  uint32_t MinInterval;     /*!< Shortest periodic calibration interval in ms */
+  uint32_t MaxInterval;     /*!< Longest periodic calibration interval in ms */
+  /**
+   * Low speed clock frequency drift, in ppm, measured between two calibrations above which
+   * the calibration interval is halved. Below a quarter of it the interval is doubled.
+   */
+  uint32_t DriftThreshold;
+} HAL_VTIMER_AdaptiveCalibrationType;
+
+typedef struct HAL_VTIMER_CalibrationStatsS {
+  uint32_t Interval;          /*!< Current periodic calibration interval in ms */
+  uint32_t LastDrift;         /*!< Frequency drift measured by the last calibration in ppm */
+  uint32_t MaxDrift;          /*!< Largest frequency drift measured in ppm */
+  uint32_t LastError;         /*!< Time base error accumulated over the last calibration interval in STU, estimated from LastDrift */
+  uint32_t CalibrationCount;  /*!< Number of periodic calibrations completed */
+} HAL_VTIMER_CalibrationStatsType;
+
+/**
+ * @brief Number of buckets of the callback latency histogram.
+ *        Bucket 0 counts the callbacks run at or before their expiry time,
+ *        bucket i the callbacks run between 2^(i-1) and 2^i - 1 STU late.
+ *        The last bucket also counts all the larger latencies.
+ */
+#define VTIMER_STATS_LATENCY_BUCKETS (24U)
+
+typedef struct HAL_VTIMER_StatsS {
+  uint32_t latencyHistogram[VTIMER_STATS_LATENCY_BUCKETS]; /*!< Callback latency (now - expiryTime) histogram, log2 buckets of STU */
+  uint32_t callbackCount;    /*!< Number of callbacks dispatched */
+  uint32_t maxLatency;       /*!< Largest callback latency, in STU */
+  uint32_t maxQueueDepth;    /*!< Largest number of timers in the queue */
+  uint32_t maskedCount;      /*!< Number of interrupt masked sections in the timeout update */
+  uint32_t maxMaskedTime;    /*!< Longest interrupt masked section in the timeout update, in MTU */
+  uint64_t totalMaskedTime;  /*!< Cumulative interrupt masked time in the timeout update, in MTU */
+} HAL_VTIMER_StatsType;
+
 /**
   * @}
   */ 
@@ -107,6 +168,30 @@ typedef struct HAL_VTIMER_InitS {
  */
 int HAL_VTIMER_StartTimerMs(VTIMER_HandleType *timerHandle, uint32_t msRelTimeout);
 
+/**
+ * @brief Starts a one-shot virtual timer for the given relative timeout value expressed in ms.
+ *        The timeout may be delayed by up to msSlack ms to share the wakeup of another timer.
+ * @param timerHandle: The virtual timer
+ * @param msRelTimeout: The relative time, from current time, expressed in ms
+ * @param msSlack: The maximum delay accepted on the timeout, expressed in ms
+ * @retval 0 if the timerHandle is valid.
+ * @retval 1 if the timerHandle is not valid. It is already started.
+ */
+int HAL_VTIMER_StartTimerMsWithSlack(VTIMER_HandleType *timerHandle, uint32_t msRelTimeout, uint32_t msSlack);
+
+/**
+ * @brief Starts a periodic virtual timer expiring every msPeriod ms, the first time msPeriod ms
+ *        from current time. Each expiry time is computed from the previous one in STU, so that
+ *        the callback latency does not cause any drift. Missed periods are skipped.
+ *        The timer runs until it is stopped or started again as a one-shot timer.
+ * @param timerHandle: The virtual timer
+ * @param msPeriod: The period expressed in ms, rounded to the nearest STU. It must not be 0.
+ * @retval 0 if the timerHandle is valid.
+ * @retval 1 if the timerHandle is not valid. It is already started.
+ * @retval 2 if msPeriod is 0. The timer is not started.
+ */
+int HAL_VTIMER_StartTimerPeriodicMs(VTIMER_HandleType *timerHandle, uint32_t msPeriod);
+
 /**
  * @brief Stops the one-shot virtual timer specified if found
  * @param  timerHandle: The virtual timer
@@ -122,6 +207,14 @@ void HAL_VTIMER_StopTimer(VTIMER_HandleType *timerHandle);
  */
 uint64_t HAL_VTIMER_GetCurrentSysTime(void);
 
+/**
+ * @brief  This function returns the system time sampled by the timer module without reading
+ *         the hardware timer. It is refreshed at least once per HAL_VTIMER_Tick() call, so it
+ *         is behind the current time by at most the time elapsed since the last tick.
+ * @return system time snapshot expressed in system time units.
+ */
+uint64_t HAL_VTIMER_GetSysTimeSnapshot(void);
+
 /**
  * @brief This function returns the sum of an absolute time and a signed relative time.
  * @param  sysTime: Absolute time expressed in internal time units.
@@ -210,6 +303,50 @@ void HAL_VTIMER_EndOfRadioActivityIsr(void);
 */
 uint32_t HAL_VTIMER_GetPendingTimers(void);
 
+/**
+ * @brief  Returns the number of wakeups saved by delaying timers within their slack.
+ *  @return number of coalesced wakeups.
+*/
+uint32_t HAL_VTIMER_GetCoalescedWakeups(void);
+
+#if VTIMER_STATS_ENABLE
+/**
+ * @brief  Copy the callback dispatch statistics collected since the initialization
+ *         or the last HAL_VTIMER_ResetStats().
+ * @param  stats: Pointer to the structure filled with the statistics
+ * @retval None
+ */
+void HAL_VTIMER_GetStats(HAL_VTIMER_StatsType *stats);
+
+/**
+ * @brief  Clear the callback dispatch statistics.
+ * @retval None
+ */
+void HAL_VTIMER_ResetStats(void);
+#else
+#define HAL_VTIMER_GetStats(stats)
+#define HAL_VTIMER_ResetStats()
+#endif
+
+/**
+ * @brief  Let the periodic calibration interval follow the low speed clock drift.
+ *         After each calibration the interval is doubled if the drift since the previous
+ *         calibration is below a quarter of DriftThreshold and halved if it is above DriftThreshold,
+ *         within MinInterval and MaxInterval. The forced calibration during the active phase
+ *         also follows the adaptive interval instead of occurring every 5 seconds.
+ * @param  config: Adaptive policy, NULL to restore the fixed interval set by HAL_VTIMER_Init()
+ * @retval 0 if the policy has been applied.
+ * @retval 1 if the periodic calibration is disabled or the bounds are not valid.
+ */
+uint8_t HAL_VTIMER_SetAdaptiveCalibration(HAL_VTIMER_AdaptiveCalibrationType *config);
+
+/**
+ * @brief  Return the achieved calibration interval and the measured drift.
+ * @param  stats: Pointer to the structure filled with the calibration statistics
+ * @retval None
+ */
+void HAL_VTIMER_GetCalibrationStats(HAL_VTIMER_CalibrationStatsType *stats);
+
 /**
  * @brief  Schedules a radio activity for the given absolute timeout value expressed in STU.
  *         If the calibration of the low speed oscillator is needed, if it is possible,
@@ -870,6 +870,16 @@ struct ActionPacket
   uint8_t trans_config;                                 /* This is for configuring the device for TX or RX. User does not need to do anything. */
 };
 
+/* Maximum filter coefficient of an RSSI filter: a sample has a weight of 1/16 */
+#define RSSI_FILTER_MAX_COEFF   (4U)
+
+typedef struct {
+  int16_t Average;              /* Average RSSI in 1/64 dBm */
+  uint8_t AttackCoeff;          /* The weight of a sample above the average is 2^-AttackCoeff */
+  uint8_t DecayCoeff;           /* The weight of a sample below the average is 2^-DecayCoeff */
+  uint8_t Valid;                /* TRUE once the first sample has been added */
+} RSSIFilter_t;
+
 /**
 * @}
 */
@@ -3265,6 +3275,9 @@ void RADIO_SetDefaultPreambleLen(uint8_t StateMachineNo);
 void RADIO_SetPreambleRep(uint8_t StateMachineNo, uint8_t PreaLen);
 void RADIO_DisableCRC(uint8_t StateMachineNo, FunctionalState hwCRC);
 int8_t RADIO_ReadRSSI(void);
+void RADIO_RSSIFilterInit(RSSIFilter_t *filter, uint8_t attack_coeff, uint8_t decay_coeff);
+int8_t RADIO_RSSIFilterUpdate(RSSIFilter_t *filter, int8_t rssi);
+int8_t RADIO_RSSIFilterGet(RSSIFilter_t *filter);
 
 /**
   * @}
@@ -76,7 +76,18 @@ typedef struct timer_calibration_s {
   * @{
   */
 
-#if defined(CONFIG_DEVICE_BLUENRG_LPS) || defined(CONFIG_DEVICE_BLUENRG_LPF)
+/**
+ * @brief  Replace the timer hardware with a virtual clock advanced by TIMER_SIM_Advance().
+ *         Intended to run the timer module off-target.
+ */
+#if defined(CONFIG_BLUENRG_LP_TIMER_SIM)
+#define TIMER_SIM_ENABLE (1)
+#else
+#define TIMER_SIM_ENABLE (0)
+#endif
+
+/* The simulated timers do not model the host wakeup shared with the radio wakeup timer */
+#if defined(CONFIG_DEVICE_BLUENRG_LPS) || defined(CONFIG_DEVICE_BLUENRG_LPF) || TIMER_SIM_ENABLE
 /**
  * @brief  Allows a virtual timer to wake up the device in BlueNRG-LP cuts 1.0 and 2.0.
  */
@@ -114,6 +125,14 @@ typedef struct timer_calibration_s {
 /** @defgroup TIMER_Exported_Macros TIMER Exported Macros
   * @{
   */ 
+#if TIMER_SIM_ENABLE
+  #define TIMER_DISABLE_TIMER12               TIMER_ClearRadioTimerValue()
+  #define TIMER_DISABLE_RADIO_TIMERS          TIMER_ClearRadioTimerValue()
+  #define TIMER_DISABLE_CM0_TIMER             TIMER_SIM_DisableHostTimer()
+  #define TIMER_GET_TIMER1_STATUS             (0)
+  #define TIMER_GET_TIMER2_STATUS             (0)
+  #define TIMER_GET_BLUE_WAKEUP_EN            TIMER_SIM_IsRadioTimerEnabled()
+#else
   #define TIMER_GET_SLOW_FREQEUNCY            (RADIO_CTRL->CLK32FREQUENCY_REG & RADIO_CTRL_CLK32FREQUENCY_REG_SLOW_FREQUENCY)
   #define TIMER_GET_SLOW_PERIOD               (RADIO_CTRL->CLK32PERIOD_REG & RADIO_CTRL_CLK32PERIOD_REG_SLOW_PERIOD)
   #define TIMER_GET_SLOW_CLK_IRQ              (RADIO_CTRL->RADIO_CONTROL_IRQ_STATUS & RADIO_CTRL_RADIO_CONTROL_IRQ_STATUS_SLOW_CLK_IRQ)
@@ -145,6 +164,7 @@ typedef struct timer_calibration_s {
 #if defined(CONFIG_DEVICE_BLUENRG_LPF)
   #define TIMER_BLUE_SET_REQ_MODE(req_mode)
 #endif
+#endif /* TIMER_SIM_ENABLE */
 
 
 /**
@@ -296,6 +316,14 @@ uint64_t TIMER_GetFutureSysTime(uint32_t time);
 */
 uint64_t TIMER_GetCurrentSysTime(void);
 
+/**
+  * @brief   Return the system time sampled by the last call to a function reading the current time,
+  *          such as TIMER_GetCurrentSysTime(), without accessing the hardware timer.
+  *          The returned value is behind the current time by the time elapsed since that call.
+  * @return  System time snapshot in STU
+*/
+uint64_t TIMER_GetSysTimeSnapshot(void);
+
 /**
  * @brief   Programs either the Wakeup timer or Timer1. Both timers are able to trigger the radio sequencer.
  *          Then, they are able to start a transmission or a reception according to the configured radio ram tables.
@@ -410,6 +438,45 @@ void TIMER_Disable_CPU_WKUP(void);
  */
 uint32_t __TIMER_GetSysRfSetupTime(void);
 
+#if TIMER_SIM_ENABLE
+/**
+ * @brief Set the current time of the virtual clock, without triggering any timer.
+ * @param time: Absolute time expressed in STU.
+ */
+void TIMER_SIM_SetCurrentSysTime(uint64_t time);
+
+/**
+ * @brief Advance the virtual clock. The host timer and the radio timer expiring
+ *        in the elapsed interval trigger HAL_VTIMER_TimeoutCallback() and
+ *        HAL_VTIMER_RadioTimerIsr() at their expiry time, in chronological order.
+ *        The simulated radio activity ends as soon as it starts.
+ * @param delay: Time to elapse, expressed in STU.
+ */
+void TIMER_SIM_Advance(uint64_t delay);
+
+/**
+ * @brief Return the expiry time of the next programmed host or radio timer.
+ * @param time: Absolute time expressed in STU.
+ * @retval TRUE if a timer is programmed, FALSE otherwise.
+ */
+BOOL TIMER_SIM_GetNextEventTime(uint64_t *time);
+
+/**
+ * @brief Disable the simulated host timer.
+ */
+void TIMER_SIM_DisableHostTimer(void);
+
+/**
+ * @brief Return TRUE if the simulated radio timer is programmed.
+ */
+BOOL TIMER_SIM_IsRadioTimerEnabled(void);
+
+/**
+ * @brief Get the current absolute time expressed in machine absolute time unit.
+ *        The simulated machine time unit is the STU.
+ */
+__STATIC_INLINE uint32_t TIMER_GetCurrentMachineTime(void) { return (uint32_t)TIMER_GetCurrentSysTime(); }
+#else
 /**
  * @brief Get the current absolute time expressed in machine absolute time unit.
  */
@@ -434,6 +501,7 @@ __STATIC_INLINE void TIMER_SetTimeoutReg(uint32_t value) { WAKEUP->BLUE_WAKEUP_T
  * @brief Get the value of a blue controller wakeup time in machine absolute time units.
  */
 __STATIC_INLINE uint32_t TIMER_GetTimeoutReg(uint32_t value) { return WAKEUP->BLUE_WAKEUP_TIME; }
+#endif /* TIMER_SIM_ENABLE */
 
 /**
   * @}
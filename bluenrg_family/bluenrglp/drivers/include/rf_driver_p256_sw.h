@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_p256_sw.h
+  * @author  RF Application Team
+  * @brief   Portable P-256 scalar multiplication
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#ifndef RF_DRIVER_P256_SW_H
+#define RF_DRIVER_P256_SW_H
+
+#include <stdint.h>
+
+/* Size of a coordinate or of a scalar in words */
+#define P256_SW_WORDS              (8U)
+
+#define P256_SW_SUCCESS            (0x00U)
+/* The point is not on the curve or a coordinate is not lower than the modulus */
+#define P256_SW_ERROR_POINT        (0x01U)
+/* The scalar is 0 or is not lower than the order of the curve */
+#define P256_SW_ERROR_SCALAR       (0x02U)
+/* A known answer of P256_SW_SelfTest() is not matched */
+#define P256_SW_ERROR_SELFTEST     (0x03U)
+
+/* The numbers are arrays of 32-bit words, least significant word first, as in the PKA RAM.
+   A point is the X coordinate followed by the Y coordinate. */
+uint32_t P256_SW_PointMul(uint32_t *result, const uint32_t *k, const uint32_t *point);
+
+uint32_t P256_SW_PointCheck(const uint32_t *point);
+
+uint32_t P256_SW_SelfTest(void);
+
+#endif /* RF_DRIVER_P256_SW_H */
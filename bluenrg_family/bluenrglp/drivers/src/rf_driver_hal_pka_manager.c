@@ -0,0 +1,280 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_pka_manager.c
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP PKA manager
+  * @details The PKA manager owns the PKA handle. The P-256 operations requested by
+  * the different users are queued as jobs of the PKA HAL (HAL_PKA_Enqueue()), which
+  * executes them one after the other in interrupt mode and calls back the manager
+  * at the end of each job. The completion and error callbacks of the HAL are not used.
+  * A user needing the PKA handle directly (e.g. for an operation not provided by the
+  * manager) takes it with PKAMGR_Lock() and gives it back with PKAMGR_Unlock(): the
+  * requests received meanwhile are kept by the manager and queued at the unlock.
+  * The manager implements PKAMGR_PowerSaveLevelCheck(), called by the power manager:
+  * the DEEPSTOP, which does not retain the PKA RAM, is not allowed while an operation
+  * is running or the PKA is locked. The PKA clock is enabled when an operation starts
+  * and only disabled when the power manager finds the PKA idle, so that the clock is
+  * not switched between requests executed back to back.
+  * The application must call PKAMGR_IRQHandler() from PKA_IRQHandler().
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#include "rf_driver_hal_pka_manager.h"
+#include "osal.h"
+
+#if defined(PKA) && defined(HAL_PKA_MODULE_ENABLED)
+
+typedef struct {
+  PKA_JobTypeDef job;        /* First member: the job callback gets the request back from the job */
+  PKAMGR_funcCB funcCB;
+  uint32_t result[16];
+} PKAMGR_RequestType;
+
+typedef struct {
+  PKA_HandleTypeDef hpka;
+  PKAMGR_RequestType queue[PKAMGR_QUEUE_SIZE];
+  uint8_t head;              /* Oldest request */
+  uint8_t count;             /* Requests not completed */
+  uint8_t submitted;         /* Requests queued in the PKA HAL, starting from the oldest one */
+  volatile uint8_t locked;
+  uint8_t clockEnabled;
+  uint8_t initialized;
+} PKAMGR_ContextType;
+
+static PKAMGR_ContextType PKAMGR_Context;
+
+static void PkaClockEnable(void)
+{
+  if(PKAMGR_Context.clockEnabled == FALSE) {
+    __HAL_RCC_PKA_CLK_ENABLE();
+    PKAMGR_Context.clockEnabled = TRUE;
+  }
+}
+
+/* End of the job of the oldest request, called by the PKA HAL. The error code of the job
+   includes the error flag written by the PKA in its RAM. */
+static void PkaJobComplete(PKA_JobTypeDef *job)
+{
+  PKAMGR_RequestType *req = (PKAMGR_RequestType *)job;
+  PKAMGR_ResultStatus status = PKAMGR_ERR_PROCESS;
+
+  if(job->ErrorCode == HAL_PKA_ERROR_NONE) {
+    status = PKAMGR_SUCCESS;
+  }
+
+  /* Free the slot before the callback, which can queue a new request. The result stays
+     valid during the callback: a request reusing the slot completes after the callback. */
+  ATOMIC_SECTION_BEGIN();
+  PKAMGR_Context.head = (PKAMGR_Context.head + 1U) % PKAMGR_QUEUE_SIZE;
+  PKAMGR_Context.count--;
+  PKAMGR_Context.submitted--;
+  ATOMIC_SECTION_END();
+
+  req->funcCB(status, req->result);
+}
+
+/* Queue in the PKA HAL the requests not queued yet, unless the PKA is locked.
+   Called with the interrupts disabled. */
+static void PkaSubmit(void)
+{
+  PKAMGR_RequestType *req;
+
+  while((PKAMGR_Context.submitted < PKAMGR_Context.count) && (PKAMGR_Context.locked == FALSE)) {
+    req = &PKAMGR_Context.queue[(PKAMGR_Context.head + PKAMGR_Context.submitted) % PKAMGR_QUEUE_SIZE];
+    PkaClockEnable();
+    PKAMGR_Context.submitted++;
+    /* Cannot fail: the handle is initialized and the job of a free slot is not pending.
+       The software PKA completes the job before returning. */
+    (void)HAL_PKA_Enqueue(&PKAMGR_Context.hpka, &req->job);
+  }
+}
+
+static PKAMGR_ResultStatus PkaRequest(const uint32_t *k, const uint32_t *point, PKAMGR_funcCB funcCB)
+{
+  PKAMGR_RequestType *req;
+
+  if((k == NULL) || (funcCB == NULL) || (PKAMGR_Context.initialized == FALSE)) {
+    return PKAMGR_ERR_PARAM;
+  }
+
+  ATOMIC_SECTION_BEGIN();
+  if(PKAMGR_Context.count == PKAMGR_QUEUE_SIZE) {
+    ATOMIC_SECTION_END();
+    return PKAMGR_ERR_BUSY;
+  }
+  req = &PKAMGR_Context.queue[(PKAMGR_Context.head + PKAMGR_Context.count) % PKAMGR_QUEUE_SIZE];
+  req->job.K = (uint32_t *)k;
+  req->job.Point = (uint32_t *)point;
+  req->job.Result = req->result;
+  req->job.Callback = PkaJobComplete;
+  req->funcCB = funcCB;
+  PKAMGR_Context.count++;
+  PkaSubmit();
+  ATOMIC_SECTION_END();
+
+  return PKAMGR_SUCCESS;
+}
+
+/**
+* @brief  This routine initializes the PKA manager and the PKA.
+* @retval PKAMGR_SUCCESS
+*/
+PKAMGR_ResultStatus PKAMGR_Init(void)
+{
+  Osal_MemSet(&PKAMGR_Context, 0, sizeof(PKAMGR_Context));
+
+  PkaClockEnable();
+  PKAMGR_Context.hpka.Instance = PKA;
+  if(HAL_PKA_Init(&PKAMGR_Context.hpka) != HAL_OK) {
+    return PKAMGR_ERR_PROCESS;
+  }
+  NVIC_EnableIRQ(PKA_IRQn);
+  PKAMGR_Context.initialized = TRUE;
+
+  return PKAMGR_SUCCESS;
+}
+
+/**
+* @brief  This routine de-initializes the PKA and disables its clock.
+* @retval PKAMGR_SUCCESS, or PKAMGR_ERR_BUSY if an operation is running, queued or the PKA is locked.
+*/
+PKAMGR_ResultStatus PKAMGR_Deinit(void)
+{
+  ATOMIC_SECTION_BEGIN();
+  if((PKAMGR_Context.count != 0U) || (PKAMGR_Context.locked != FALSE)) {
+    ATOMIC_SECTION_END();
+    return PKAMGR_ERR_BUSY;
+  }
+  PKAMGR_Context.initialized = FALSE;
+  ATOMIC_SECTION_END();
+
+  NVIC_DisableIRQ(PKA_IRQn);
+  PkaClockEnable();
+  HAL_PKA_DeInit(&PKAMGR_Context.hpka);
+  __HAL_RCC_PKA_CLK_DISABLE();
+  PKAMGR_Context.clockEnabled = FALSE;
+
+  return PKAMGR_SUCCESS;
+}
+
+/**
+* @brief  This routine queues the computation of a P-256 public key: privateKey.G,
+*         G being the generator of the curve.
+* @param  privateKey: private key, 8 words, least significant word first.
+*         It must not be modified until the callback is called.
+* @param  funcCB: called in the PKA interrupt with the public key.
+* @retval PKAMGR_SUCCESS, PKAMGR_ERR_PARAM, or PKAMGR_ERR_BUSY if the request queue is full.
+*/
+PKAMGR_ResultStatus PKAMGR_StartP256PublicKeyGeneration(const uint32_t *privateKey, PKAMGR_funcCB funcCB)
+{
+  return PkaRequest(privateKey, NULL, funcCB);
+}
+
+/**
+* @brief  This routine queues the computation of a P-256 Diffie-Hellman key: secretKey.publicKey.
+*         The X coordinate of the result is the DH key. PKAMGR_ERR_PROCESS is reported to the
+*         callback if the public key is not on the curve.
+* @param  secretKey: local private key, 8 words, least significant word first.
+* @param  publicKey: X and Y coordinates of the remote public key, 16 words.
+*         Both buffers must not be modified until the callback is called.
+* @param  funcCB: called in the PKA interrupt with the result.
+* @retval PKAMGR_SUCCESS, PKAMGR_ERR_PARAM, or PKAMGR_ERR_BUSY if the request queue is full.
+*/
+PKAMGR_ResultStatus PKAMGR_StartP256DHkeyGeneration(const uint32_t *secretKey, const uint32_t *publicKey, PKAMGR_funcCB funcCB)
+{
+  if(publicKey == NULL) {
+    return PKAMGR_ERR_PARAM;
+  }
+  return PkaRequest(secretKey, publicKey, funcCB);
+}
+
+/**
+* @brief  This routine gives the exclusive use of the PKA handle to the caller, see PKAMGR_GetHandle().
+*         The queued requests are started when the PKA is unlocked. The DEEPSTOP is not
+*         allowed while the PKA is locked.
+* @retval PKAMGR_SUCCESS, or PKAMGR_ERR_BUSY if the PKA is already locked or in use by a request.
+*/
+PKAMGR_ResultStatus PKAMGR_Lock(void)
+{
+  ATOMIC_SECTION_BEGIN();
+  if((PKAMGR_Context.locked != FALSE) || (PKAMGR_Context.count != 0U) || (PKAMGR_Context.initialized == FALSE) ||
+     (HAL_PKA_GetQueueDepth(&PKAMGR_Context.hpka) != 0U)) {
+    ATOMIC_SECTION_END();
+    return PKAMGR_ERR_BUSY;
+  }
+  PKAMGR_Context.locked = TRUE;
+  PkaClockEnable();
+  ATOMIC_SECTION_END();
+
+  return PKAMGR_SUCCESS;
+}
+
+/**
+* @brief  This routine releases the PKA locked with PKAMGR_Lock() and starts the queued requests.
+*         The operations and jobs started on the handle must be completed.
+* @retval PKAMGR_SUCCESS
+*/
+PKAMGR_ResultStatus PKAMGR_Unlock(void)
+{
+  ATOMIC_SECTION_BEGIN();
+  PKAMGR_Context.locked = FALSE;
+  PkaSubmit();
+  ATOMIC_SECTION_END();
+
+  return PKAMGR_SUCCESS;
+}
+
+/**
+* @brief  This routine returns the PKA handle, to be used between PKAMGR_Lock() and PKAMGR_Unlock().
+*         The job queue of the handle is empty while the PKA is locked: the operations can be
+*         done in blocking mode, in interrupt mode with the HAL callbacks, or with HAL_PKA_Enqueue().
+* @retval PKA handle
+*/
+PKA_HandleTypeDef *PKAMGR_GetHandle(void)
+{
+  return &PKAMGR_Context.hpka;
+}
+
+/**
+* @brief  This routine returns the lowest power save level allowed by the PKA.
+*         It is called by HAL_PWR_MNGR_Request() with the interrupts disabled.
+*         If the PKA is idle, its clock is disabled.
+* @param  level: power save level requested.
+* @retval POWER_SAVE_LEVEL_CPU_HALT if a request is not completed or the PKA is locked,
+*         POWER_SAVE_LEVEL_STOP_NOTIMER otherwise.
+*/
+uint8_t PKAMGR_PowerSaveLevelCheck(uint8_t level)
+{
+  if((PKAMGR_Context.count != 0U) || (PKAMGR_Context.locked != FALSE)) {
+    return POWER_SAVE_LEVEL_CPU_HALT;
+  }
+
+  if(PKAMGR_Context.clockEnabled != FALSE) {
+    __HAL_RCC_PKA_CLK_DISABLE();
+    PKAMGR_Context.clockEnabled = FALSE;
+  }
+  return POWER_SAVE_LEVEL_STOP_NOTIMER;
+}
+
+/**
+* @brief  This routine handles the PKA interrupt. It must be called from PKA_IRQHandler().
+* @retval None
+*/
+void PKAMGR_IRQHandler(void)
+{
+  HAL_PKA_IRQHandler(&PKAMGR_Context.hpka);
+}
+
+#endif /* defined(PKA) && defined(HAL_PKA_MODULE_ENABLED) */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
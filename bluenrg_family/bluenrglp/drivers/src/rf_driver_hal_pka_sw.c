@@ -0,0 +1,1265 @@
+/**
+******************************************************************************
+* @file    rf_driver_hal_pka_sw.c
+* @author  RF Application Team
+* @brief   PKA HAL module driver implemented by software.
+*          This file replaces rf_driver_hal_pka_v7b.c when
+*          CONFIG_BLUENRG_LP_HAL_PKA_SOFTWARE is set. It implements the same
+*          API with the portable P-256 scalar multiplication of
+*          rf_driver_p256_sw.c, without accessing the PKA registers and RAM,
+*          so that the users of the PKA can run off-target:
+*           + Initialization and de-initialization functions
+*           + Start an operation
+*           + Retrieve the operation result
+*
+@verbatim
+==============================================================================
+##### How to use this driver #####
+==============================================================================
+[..]
+The PKA HAL driver can be used as follows:
+
+(#) Declare a PKA_HandleTypeDef handle structure, for example: PKA_HandleTypeDef  hpka;
+
+(#) Initialize the PKA low level resources by implementing the HAL_PKA_MspInit() API:
+(##) Enable the PKA interface clock
+(##) NVIC configuration if you need to use interrupt process
+(+++) Configure the PKA interrupt priority
+(+++) Enable the NVIC PKA IRQ Channel
+
+(#) Initialize the PKA registers by calling the HAL_PKA_Init() API which trig
+HAL_PKA_MspInit().
+
+(#) Execute the operation (in polling or interrupt) and check the returned value.
+
+(#) Retrieve the result of the operation by calling the HAL_PKA_GetResult()
+
+*** Differences with the hardware ***
+===================================
+[..]
+(+) The results are the same as with the PKA.
+(+) The operation is computed by the CPU in HAL_PKA_StartProc() and
+    HAL_PKA_StartProc_IT(). The timeout is not used.
+(+) In interrupt mode, the completion or error callback is called before
+    HAL_PKA_StartProc_IT() returns. HAL_PKA_IRQHandler() has nothing to do.
+(+) The jobs of the queue are run by HAL_PKA_Enqueue(), their callback is
+    called before it returns. A job queued by a job callback is run after the
+    callback returns, by the HAL_PKA_Enqueue() call that runs the queue.
+(+) The PKA RAM is a static variable of this file, the Instance field of
+    the handle is not used.
+
+(#) Call the function HAL_PKA_DeInit() to restore the default configuration which trig
+HAL_PKA_MspDeInit().
+
+*** Polling mode operation ***
+===================================
+[..]
+(+) When an operation is started in polling mode, the function returns when
+    the operation is completed.
+
+*** Interrupt mode operation ***
+===================================
+[..]
+(+) When an operation is started in interrupt mode, the function returns
+    after the callback.
+(+) When the operation is completed, the callback HAL_PKA_OperationCpltCallback is called.
+(+) When an error is encountered, the callback HAL_PKA_ErrorCallback is called.
+
+*** Utilities ***
+===================================
+[..]
+(+) To get current state, use HAL_PKA_GetState().
+(+) To get current error, use HAL_PKA_GetError().
+
+*** Callback registration ***
+=============================================
+[..]
+
+The compilation flag USE_HAL_PKA_REGISTER_CALLBACKS, when set to 1,
+allows the user to configure dynamically the driver callbacks.
+Use Functions @ref HAL_PKA_RegisterCallback()
+to register an interrupt callback.
+[..]
+
+Function @ref HAL_PKA_RegisterCallback() allows to register following callbacks:
+(+) OperationCpltCallback : callback for End of operation.
+(+) ErrorCallback         : callback for error detection.
+(+) MspInitCallback       : callback for Msp Init.
+(+) MspDeInitCallback     : callback for Msp DeInit.
+This function takes as parameters the HAL peripheral handle, the Callback ID
+and a pointer to the user callback function.
+[..]
+
+Use function @ref HAL_PKA_UnRegisterCallback to reset a callback to the default
+weak function.
+[..]
+
+@ref HAL_PKA_UnRegisterCallback takes as parameters the HAL peripheral handle,
+and the Callback ID.
+This function allows to reset following callbacks:
+(+) OperationCpltCallback : callback for End of operation.
+(+) ErrorCallback         : callback for error detection.
+(+) MspInitCallback       : callback for Msp Init.
+(+) MspDeInitCallback     : callback for Msp DeInit.
+[..]
+
+By default, after the @ref HAL_PKA_Init() and when the state is @ref HAL_PKA_STATE_RESET
+all callbacks are set to the corresponding weak functions:
+examples @ref HAL_PKA_OperationCpltCallback(), @ref HAL_PKA_ErrorCallback().
+Exception done for MspInit and MspDeInit functions that are
+reset to the legacy weak functions in the @ref HAL_PKA_Init()/ @ref HAL_PKA_DeInit() only when
+these callbacks are null (not registered beforehand).
+[..]
+
+If MspInit or MspDeInit are not null, the @ref HAL_PKA_Init()/ @ref HAL_PKA_DeInit()
+keep and use the user MspInit/MspDeInit callbacks (registered beforehand) whatever the state.
+[..]
+
+Callbacks can be registered/unregistered in @ref HAL_PKA_STATE_READY state only.
+Exception done MspInit/MspDeInit functions that can be registered/unregistered
+in @ref HAL_PKA_STATE_READY or @ref HAL_PKA_STATE_RESET state,
+thus registered (user) MspInit/DeInit callbacks can be used during the Init/DeInit.
+[..]
+
+Then, the user first registers the MspInit/MspDeInit user callbacks
+using @ref HAL_PKA_RegisterCallback() before calling @ref HAL_PKA_DeInit()
+or @ref HAL_PKA_Init() function.
+[..]
+
+When the compilation flag USE_HAL_PKA_REGISTER_CALLBACKS is set to 0 or
+not defined, the callback registration feature is not available and all callbacks
+are set to the corresponding weak functions.
+
+@endverbatim  
+******************************************************************************
+* @attention
+*
+* <h2><center>&copy; Copyright (c) 2020 STMicroelectronics. 
+* All rights reserved.</center></h2>
+*
+* This software component is licensed by ST under BSD 3-Clause license,
+* the "License"; You may not use this file except in compliance with the 
+* License. You may obtain a copy of the License at:
+*                        opensource.org/licenses/BSD-3-Clause
+*
+******************************************************************************
+*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rf_driver_hal.h"
+#include "rf_driver_p256_sw.h"
+
+/** @addtogroup RF_DRIVER_HAL_Driver
+* @{
+*/
+
+#if defined(PKA) && defined(HAL_PKA_MODULE_ENABLED)
+
+/** @defgroup PKA PKA
+* @brief PKA HAL module driver.
+* @{
+*/
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/** @defgroup PKA_Private_Define PKA Private Define
+* @{
+*/
+#define PKA_SW_RAM_WORDS (P256_SW_WORDS + 1U)
+/**
+* @}
+*/
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** @defgroup PKA_Private_Variables PKA Private Variables
+* @{
+*/
+/* Same content as the PKA RAM. Each value is followed by a word of zeros. */
+static struct {
+  uint32_t KpError;
+  uint32_t K[PKA_SW_RAM_WORDS];
+  uint32_t PointX[PKA_SW_RAM_WORDS];
+  uint32_t PointY[PKA_SW_RAM_WORDS];
+} PKA_SW_RAM;
+/**
+* @}
+*/
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup PKA_Private_Functions PKA Private Functions
+* @{
+*/
+void PKA_Compute(void);
+uint32_t PKA_CheckError(PKA_HandleTypeDef *hpka);
+static int rev_memcmp(uint8_t *a, const uint8_t *b, uint8_t  bufferSize);
+uint32_t PKA_SetData(uint8_t dataType, uint32_t* srcData);
+static void PKA_Queue_Start(PKA_HandleTypeDef *hpka);
+static void PKA_Queue_Complete(PKA_HandleTypeDef *hpka);
+static void PKA_Queue_Flush(PKA_HandleTypeDef *hpka);
+/**
+* @}
+*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @defgroup PKA_Exported_Functions PKA Exported Functions
+* @{
+*/
+
+/** @defgroup PKA_Exported_Functions_Group1 Initialization and de-initialization functions
+*  @brief   Initialization and de-initialization functions
+*
+@verbatim
+===============================================================================
+##### Initialization and de-initialization functions  #####
+===============================================================================
+[..]  This subsection provides a set of functions allowing to initialize and
+deinitialize the PKAx peripheral:
+
+(+) User must implement HAL_PKA_MspInit() function in which he configures
+all related peripherals resources (CLOCK, IT and NVIC ).
+
+(+) Call the function HAL_PKA_Init() to configure the selected device with
+the selected configuration:
+(++) Security level
+
+(+) Call the function HAL_PKA_DeInit() to restore the default configuration
+of the selected PKAx peripheral.
+
+@endverbatim
+* @{
+*/
+
+/**
+* @brief  Initialize the PKA according to the specified
+*         parameters in the PKA_InitTypeDef and initialize the associated handle.
+* @param  hpka PKA handle
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_Init(PKA_HandleTypeDef *hpka)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  
+  /* Check the PKA handle allocation */
+  if (hpka != NULL)
+  {
+    if (hpka->State == HAL_PKA_STATE_RESET)
+    {
+      
+#if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
+      /* Init the PKA Callback settings */
+      hpka->OperationCpltCallback = HAL_PKA_OperationCpltCallback; /* Legacy weak OperationCpltCallback */
+      hpka->ErrorCallback         = HAL_PKA_ErrorCallback;         /* Legacy weak ErrorCallback         */
+      
+      if (hpka->MspInitCallback == NULL)
+      {
+        hpka->MspInitCallback = HAL_PKA_MspInit; /* Legacy weak MspInit  */
+      }
+      
+      /* Init the low level hardware */
+      hpka->MspInitCallback(hpka);
+#else
+      /* Init the low level hardware */
+      HAL_PKA_MspInit(hpka);
+#endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+    }
+    
+    /* Set the state to busy */
+    hpka->State = HAL_PKA_STATE_BUSY;
+    
+    /* Reset the result of the previous operation */
+    PKA_SW_RAM.KpError = 0U;
+    
+    /* Initialize the error code */
+    hpka->ErrorCode = HAL_PKA_ERROR_NONE;
+    
+    /* Initialize the job queue */
+    hpka->JobHead = NULL;
+    hpka->JobTail = NULL;
+    hpka->JobRunning = 0UL;
+    hpka->QueueStats.Depth = 0UL;
+    HAL_PKA_ResetQueueStats(hpka);
+    
+    /* Set the state to ready */
+    hpka->State = HAL_PKA_STATE_READY;
+  }
+  else
+  {
+    err = HAL_ERROR;
+  }
+  
+  return err;
+}
+
+/**
+* @brief  DeInitialize the PKA peripheral.
+* @param  hpka PKA handle
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_DeInit(PKA_HandleTypeDef *hpka)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  
+  /* Check the PKA handle allocation */
+  if (hpka != NULL)
+  {
+    /* Set the state to busy */
+    hpka->State = HAL_PKA_STATE_BUSY;
+    
+    /* Reset the result of the previous operation */
+    PKA_SW_RAM.KpError = 0U;
+    
+    /* Drop the queued jobs */
+    PKA_Queue_Flush(hpka);
+    
+#if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
+    if (hpka->MspDeInitCallback == NULL)
+    {
+      hpka->MspDeInitCallback = HAL_PKA_MspDeInit; /* Legacy weak MspDeInit  */
+    }
+    
+    /* DeInit the low level hardware: GPIO, CLOCK, NVIC */
+    hpka->MspDeInitCallback(hpka);
+#else
+    /* DeInit the low level hardware: CLOCK, NVIC */
+    HAL_PKA_MspDeInit(hpka);
+#endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+    
+    /* Reset the error code */
+    hpka->ErrorCode = HAL_PKA_ERROR_NONE;
+    
+    /* Reset the state */
+    hpka->State = HAL_PKA_STATE_RESET;
+  }
+  else
+  {
+    err = HAL_ERROR;
+  }
+  
+  return err;
+}
+
+/**
+* @brief  Initialize the PKA MSP.
+* @param  hpka PKA handle
+* @retval None
+*/
+WEAK_FUNCTION(void HAL_PKA_MspInit(PKA_HandleTypeDef *hpka))
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hpka);
+  
+  /* NOTE : This function should not be modified, when the callback is needed,
+  the HAL_PKA_MspInit can be implemented in the user file
+  */
+}
+
+/**
+* @brief  DeInitialize the PKA MSP.
+* @param  hpka PKA handle
+* @retval None
+*/
+WEAK_FUNCTION(void HAL_PKA_MspDeInit(PKA_HandleTypeDef *hpka))
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hpka);
+  
+  /* NOTE : This function should not be modified, when the callback is needed,
+  the HAL_PKA_MspDeInit can be implemented in the user file
+  */
+}
+
+#if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
+/**
+* @brief  Register a User PKA Callback
+*         To be used instead of the weak predefined callback
+* @param  hpka Pointer to a PKA_HandleTypeDef structure that contains
+*                the configuration information for the specified PKA.
+* @param  CallbackID ID of the callback to be registered
+*         This parameter can be one of the following values:
+*          @arg @ref HAL_PKA_OPERATION_COMPLETE_CB_ID End of operation callback ID
+*          @arg @ref HAL_PKA_ERROR_CB_ID Error callback ID
+*          @arg @ref HAL_PKA_MSPINIT_CB_ID MspInit callback ID
+*          @arg @ref HAL_PKA_MSPDEINIT_CB_ID MspDeInit callback ID
+* @param  pCallback pointer to the Callback function
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_RegisterCallback(PKA_HandleTypeDef *hpka, HAL_PKA_CallbackIDTypeDef CallbackID, pPKA_CallbackTypeDef pCallback)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  
+  if (pCallback == NULL)
+  {
+    /* Update the error code */
+    hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+    
+    return HAL_ERROR;
+  }
+  
+  if (HAL_PKA_STATE_READY == hpka->State)
+  {
+    switch (CallbackID)
+    {
+    case HAL_PKA_OPERATION_COMPLETE_CB_ID :
+      hpka->OperationCpltCallback = pCallback;
+      break;
+      
+    case HAL_PKA_ERROR_CB_ID :
+      hpka->ErrorCallback = pCallback;
+      break;
+      
+    case HAL_PKA_MSPINIT_CB_ID :
+      hpka->MspInitCallback = pCallback;
+      break;
+      
+    case HAL_PKA_MSPDEINIT_CB_ID :
+      hpka->MspDeInitCallback = pCallback;
+      break;
+      
+    default :
+      /* Update the error code */
+      hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+      
+      /* Return error status */
+      status = HAL_ERROR;
+      break;
+    }
+  }
+  else if (HAL_PKA_STATE_RESET == hpka->State)
+  {
+    switch (CallbackID)
+    {
+    case HAL_PKA_MSPINIT_CB_ID :
+      hpka->MspInitCallback = pCallback;
+      break;
+      
+    case HAL_PKA_MSPDEINIT_CB_ID :
+      hpka->MspDeInitCallback = pCallback;
+      break;
+      
+    default :
+      /* Update the error code */
+      hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+      
+      /* Return error status */
+      status = HAL_ERROR;
+      break;
+    }
+  }
+  else
+  {
+    /* Update the error code */
+    hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+    
+    /* Return error status */
+    status =  HAL_ERROR;
+  }
+  
+  return status;
+}
+
+/**
+* @brief  Unregister a PKA Callback
+*         PKA callback is redirected to the weak predefined callback
+* @param  hpka Pointer to a PKA_HandleTypeDef structure that contains
+*                the configuration information for the specified PKA.
+* @param  CallbackID ID of the callback to be unregistered
+*         This parameter can be one of the following values:
+*          @arg @ref HAL_PKA_OPERATION_COMPLETE_CB_ID End of operation callback ID
+*          @arg @ref HAL_PKA_ERROR_CB_ID Error callback ID
+*          @arg @ref HAL_PKA_MSPINIT_CB_ID MspInit callback ID
+*          @arg @ref HAL_PKA_MSPDEINIT_CB_ID MspDeInit callback ID
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_UnRegisterCallback(PKA_HandleTypeDef *hpka, HAL_PKA_CallbackIDTypeDef CallbackID)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  
+  if (HAL_PKA_STATE_READY == hpka->State)
+  {
+    switch (CallbackID)
+    {
+    case HAL_PKA_OPERATION_COMPLETE_CB_ID :
+      hpka->OperationCpltCallback = HAL_PKA_OperationCpltCallback; /* Legacy weak OperationCpltCallback */
+      break;
+      
+    case HAL_PKA_ERROR_CB_ID :
+      hpka->ErrorCallback = HAL_PKA_ErrorCallback;                 /* Legacy weak ErrorCallback        */
+      break;
+      
+    case HAL_PKA_MSPINIT_CB_ID :
+      hpka->MspInitCallback = HAL_PKA_MspInit;                     /* Legacy weak MspInit              */
+      break;
+      
+    case HAL_PKA_MSPDEINIT_CB_ID :
+      hpka->MspDeInitCallback = HAL_PKA_MspDeInit;                 /* Legacy weak MspDeInit            */
+      break;
+      
+    default :
+      /* Update the error code */
+      hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+      
+      /* Return error status */
+      status =  HAL_ERROR;
+      break;
+    }
+  }
+  else if (HAL_PKA_STATE_RESET == hpka->State)
+  {
+    switch (CallbackID)
+    {
+    case HAL_PKA_MSPINIT_CB_ID :
+      hpka->MspInitCallback = HAL_PKA_MspInit;                   /* Legacy weak MspInit              */
+      break;
+      
+    case HAL_PKA_MSPDEINIT_CB_ID :
+      hpka->MspDeInitCallback = HAL_PKA_MspDeInit;               /* Legacy weak MspDeInit            */
+      break;
+      
+    default :
+      /* Update the error code */
+      hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+      
+      /* Return error status */
+      status =  HAL_ERROR;
+      break;
+    }
+  }
+  else
+  {
+    /* Update the error code */
+    hpka->ErrorCode |= HAL_PKA_ERROR_INVALID_CALLBACK;
+    
+    /* Return error status */
+    status =  HAL_ERROR;
+  }
+  
+  return status;
+}
+
+#endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+
+/**
+* @}
+*/
+
+/** @defgroup PKA_Exported_Functions_Group2 IO operation functions
+*  @brief   IO operation functions
+*
+@verbatim
+===============================================================================
+##### IO operation functions #####
+===============================================================================
+[..]
+This subsection provides a set of functions allowing to manage the PKA operations.
+
+(#) There are two modes of operation:
+
+(++) Blocking mode : The operation is performed in the polling mode.
+These functions return when data operation is completed.
+(++) No-Blocking mode : The operation is performed by the CPU before
+the callbacks are called. These functions return after the callbacks.
+The end of the operation is indicated by HAL_PKA_ErrorCallback in case of error.
+The end of the operation is indicated by HAL_PKA_OperationCpltCallback in case of success.
+To stop any operation in interrupt mode, use HAL_PKA_Abort().
+
+(#) Blocking mode functions are :
+
+(++) HAL_PKA_StartProc()
+
+(#) No-Blocking mode functions with Interrupt are :
+
+(++) HAL_PKA_StartProc_IT();
+(++) HAL_PKA_Abort();
+
+(#) Job queue functions are :
+
+(++) HAL_PKA_Enqueue() adds a PKA_JobTypeDef to the queue and runs the queue:
+the result of each job is copied in its Result buffer and the job callback
+is called before the function returns.
+(++) HAL_PKA_GetQueueDepth(), HAL_PKA_GetQueueStats() and HAL_PKA_ResetQueueStats()
+monitor the queue.
+
+@endverbatim
+* @{
+*/
+
+/**
+* @brief  Start Process Data in blocking mode.
+* @param  hpka PKA handle
+* @param  randomK 16 word random for point 
+* @param  Timeout Timeout duration
+* @param  PKAStartPoint Parametric PKA Start Point, if NULL it will be equal to the internal PKAStartPoint
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_StartProc(PKA_HandleTypeDef *hpka, uint32_t *randomK, uint32_t Timeout, uint32_t *PKAStartPoint)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  uint32_t PKAInternalStartPoint[16] = {
+    INITIAL_START_POINT_X_W1, INITIAL_START_POINT_X_W2, INITIAL_START_POINT_X_W3, INITIAL_START_POINT_X_W4,
+    INITIAL_START_POINT_X_W5, INITIAL_START_POINT_X_W6, INITIAL_START_POINT_X_W7, INITIAL_START_POINT_X_W8,
+    INITIAL_START_POINT_Y_W1, INITIAL_START_POINT_Y_W2, INITIAL_START_POINT_Y_W3, INITIAL_START_POINT_Y_W4,
+    INITIAL_START_POINT_Y_W5, INITIAL_START_POINT_Y_W6, INITIAL_START_POINT_Y_W7, INITIAL_START_POINT_Y_W8};
+  
+  UNUSED(Timeout);
+  
+  if(PKAStartPoint == NULL){
+    PKAStartPoint = PKAInternalStartPoint;
+  }
+  
+  if (hpka->State == HAL_PKA_STATE_READY)
+  {
+    /* Set the state to busy */
+    hpka->State = HAL_PKA_STATE_BUSY;
+    
+    /* Clear any pending error */
+    hpka->ErrorCode = HAL_PKA_ERROR_NONE;
+    
+    /* Insert the random K for point */
+    hpka->ErrorCode |= PKA_SetData(PKA_DATA_SK, randomK);
+    
+    /* Insert the initial starting point coordinates */
+    hpka->ErrorCode |= PKA_SetData(PKA_DATA_PCX, (uint32_t *)&PKAStartPoint[0]);
+    hpka->ErrorCode |= PKA_SetData(PKA_DATA_PCY, (uint32_t *)&PKAStartPoint[8]);
+    
+    /* Do the computation */
+    PKA_Compute();
+    
+    /* Check error */
+    hpka->ErrorCode |= PKA_CheckError(hpka);
+    
+    /* Set the state to ready */
+    hpka->State = HAL_PKA_STATE_READY;
+    
+    /* Manage the result based on encountered errors */
+    if (hpka->ErrorCode != HAL_PKA_ERROR_NONE)
+    {
+      err = HAL_ERROR;
+    }
+  }
+  else
+  {
+    err = HAL_ERROR;
+  }
+  return err;
+}
+
+
+/**
+* @brief  Start Process Data in non-blocking mode with Interrupt.
+* @param  hpka PKA handle
+* @param  randomK 16 word random for point 
+* @param  Timeout Timeout duration
+* @param  PKAStartPoint Parametric PKA Start Point, if NULL it will be equal to the internal PKAStartPoint
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_StartProc_IT(PKA_HandleTypeDef *hpka, uint32_t *randomK, uint32_t Timeout, uint32_t *PKAStartPoint)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  uint32_t PKAInternalStartPoint[16] = {
+    INITIAL_START_POINT_X_W1, INITIAL_START_POINT_X_W2, INITIAL_START_POINT_X_W3, INITIAL_START_POINT_X_W4,
+    INITIAL_START_POINT_X_W5, INITIAL_START_POINT_X_W6, INITIAL_START_POINT_X_W7, INITIAL_START_POINT_X_W8,
+    INITIAL_START_POINT_Y_W1, INITIAL_START_POINT_Y_W2, INITIAL_START_POINT_Y_W3, INITIAL_START_POINT_Y_W4,
+    INITIAL_START_POINT_Y_W5, INITIAL_START_POINT_Y_W6, INITIAL_START_POINT_Y_W7, INITIAL_START_POINT_Y_W8};
+  
+  UNUSED(Timeout);
+  
+  if(PKAStartPoint == NULL){
+    PKAStartPoint = PKAInternalStartPoint;
+  }
+  
+  if (hpka->State == HAL_PKA_STATE_READY)
+  {
+    /* Set the state to busy */
+    hpka->State = HAL_PKA_STATE_BUSY;
+    
+    /* Clear any pending error */
+    hpka->ErrorCode = HAL_PKA_ERROR_NONE;
+    
+    /* Insert the random K for point */
+    hpka->ErrorCode |= PKA_SetData(PKA_DATA_SK, randomK);
+    
+    /* Insert the initial starting point coordinates */
+    hpka->ErrorCode |= PKA_SetData(PKA_DATA_PCX, (uint32_t *)&PKAStartPoint[0]);
+    hpka->ErrorCode |= PKA_SetData(PKA_DATA_PCY, (uint32_t *)&PKAStartPoint[8]);
+    
+    /* Do the computation */
+    PKA_Compute();
+    
+    /* Check error */
+    hpka->ErrorCode |= PKA_CheckError(hpka);
+    
+    /* Set the state to ready */
+    hpka->State = HAL_PKA_STATE_READY;
+    
+    /* Report the end of the operation as the interrupt handler does */
+    if (hpka->ErrorCode != HAL_PKA_ERROR_NONE)
+    {
+#if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
+      hpka->ErrorCallback(hpka);
+#else
+      HAL_PKA_ErrorCallback(hpka);
+#endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+    }
+    else
+    {
+#if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
+      hpka->OperationCpltCallback(hpka);
+#else
+      HAL_PKA_OperationCpltCallback(hpka);
+#endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+    }
+  }
+  else
+  {
+    err = HAL_ERROR;
+  }
+  return err;
+  
+}
+
+
+
+/**
+* @brief  Retrieve operation result.
+* @param  hpka PKA handle
+* @param  dataType: select the region of PKA RAM to read:
+*         @arg PKA_DATA_SK is the K value
+*         @arg PKA_DATA_PCX is the point X coordinate
+*         @arg PKA_DATA_PCY is the point Y coordinate 
+* @param  pRes Output buffer
+* @retval HAL status
+*/
+void HAL_PKA_GetResult(PKA_HandleTypeDef *hpka, uint8_t dataType, uint8_t *pRes)
+{
+  uint32_t *StartAddress;
+  
+  if (dataType == PKA_DATA_SK)
+    StartAddress = PKA_SW_RAM.K;
+  else if (dataType == PKA_DATA_PCX)
+    StartAddress = PKA_SW_RAM.PointX;
+  else if (dataType == PKA_DATA_PCY)
+    StartAddress = PKA_SW_RAM.PointY;
+  else
+  {
+    hpka->ErrorCode |= HAL_PKA_ERROR_OPERATION;
+    return;
+  }
+  
+  /* Read the data from the PKA RAM, least significant byte first. */
+  for(uint8_t i=0;i<32;i++) {
+    pRes[i] = (uint8_t)(StartAddress[i >> 2] >> (8U * (i & 3U)));
+  }
+}
+
+/**
+* @brief  Abort any ongoing operation.
+* @param  hpka PKA handle
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_Abort(PKA_HandleTypeDef *hpka)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  
+  /* No operation can be in progress: the operations complete before returning */
+  PKA_SW_RAM.KpError = 0U;
+  
+  /* Reset the error code */
+  hpka->ErrorCode = HAL_PKA_ERROR_NONE;
+  
+  /* Reset the state */
+  hpka->State = HAL_PKA_STATE_READY;
+  
+  /* Drop the queued jobs */
+  PKA_Queue_Flush(hpka);
+  
+  return err;
+}
+
+/**
+* @brief  Reset the PKA RAM.
+* @param  hpka PKA handle
+* @retval None
+*/
+void HAL_PKA_RAMReset(PKA_HandleTypeDef *hpka)
+{
+  uint8_t i;
+  
+  UNUSED(hpka);
+  
+  for(i=0; i<PKA_SW_RAM_WORDS; i++)
+  {
+    PKA_SW_RAM.K[i] = 0;
+    PKA_SW_RAM.PointX[i] = 0;
+    PKA_SW_RAM.PointY[i] = 0;
+  }
+}
+
+/**
+* @brief  This function handles PKA event interrupt request.
+*         Kept for compatibility with the hardware driver.
+* @param  hpka PKA handle
+* @retval None
+*/
+void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka)
+{
+  /* The operations complete in HAL_PKA_StartProc_IT(): there is no interrupt to handle */
+  UNUSED(hpka);
+}
+
+/**
+* @brief  Add a job to the PKA queue and run the queue.
+* @param  hpka PKA handle
+* @param  job Job to run. The job and its buffers must remain valid until its
+*         callback is called.
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_Enqueue(PKA_HandleTypeDef *hpka, PKA_JobTypeDef *job)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  
+  if ((job == NULL) || (job->K == NULL) || (hpka->State == HAL_PKA_STATE_RESET))
+  {
+    return HAL_ERROR;
+  }
+  
+  ATOMIC_SECTION_BEGIN();
+  
+  /* A job can be in the queue only once */
+  if (job->Pending != 0UL)
+  {
+    err = HAL_ERROR;
+  }
+  else
+  {
+    job->Pending = 1UL;
+    job->ErrorCode = HAL_PKA_ERROR_NONE;
+    job->EnqueueTick = HAL_GetTick();
+    job->Next = NULL;
+    
+    if (hpka->JobTail == NULL)
+    {
+      hpka->JobHead = job;
+    }
+    else
+    {
+      hpka->JobTail->Next = job;
+    }
+    hpka->JobTail = job;
+    
+    hpka->QueueStats.Depth++;
+    if (hpka->QueueStats.Depth > hpka->QueueStats.MaxDepth)
+    {
+      hpka->QueueStats.MaxDepth = hpka->QueueStats.Depth;
+    }
+  }
+  
+  ATOMIC_SECTION_END();
+  
+  /* The computation is done with the interrupts enabled */
+  if (err == HAL_OK)
+  {
+    PKA_Queue_Start(hpka);
+  }
+  
+  return err;
+}
+
+/**
+* @brief  Return the number of jobs in the queue, the job in progress included.
+* @param  hpka PKA handle
+* @retval Queue depth
+*/
+uint32_t HAL_PKA_GetQueueDepth(PKA_HandleTypeDef *hpka)
+{
+  return hpka->QueueStats.Depth;
+}
+
+/**
+* @brief  Retrieve the queue depth and the job counters.
+* @param  hpka PKA handle
+* @param  stats Copy of the counters
+* @retval None
+*/
+void HAL_PKA_GetQueueStats(PKA_HandleTypeDef *hpka, PKA_QueueStatsTypeDef *stats)
+{
+  ATOMIC_SECTION_BEGIN();
+  *stats = hpka->QueueStats;
+  ATOMIC_SECTION_END();
+}
+
+/**
+* @brief  Clear the job counters. The maximum depth restarts from the current depth.
+* @param  hpka PKA handle
+* @retval None
+*/
+void HAL_PKA_ResetQueueStats(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobStatsTypeDef *stats = &hpka->QueueStats.Jobs;
+  
+  ATOMIC_SECTION_BEGIN();
+  hpka->QueueStats.MaxDepth = hpka->QueueStats.Depth;
+  stats->Count = 0UL;
+  stats->Errors = 0UL;
+  stats->TotalTime = 0UL;
+  stats->MaxTime = 0UL;
+  stats->TotalLatency = 0UL;
+  stats->MaxLatency = 0UL;
+  ATOMIC_SECTION_END();
+}
+
+/**
+* @brief  Process completed callback.
+* @param  hpka PKA handle
+* @retval None
+*/
+WEAK_FUNCTION(void HAL_PKA_OperationCpltCallback(PKA_HandleTypeDef *hpka))
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hpka);
+  
+  /* NOTE : This function should not be modified, when the callback is needed,
+  the HAL_PKA_OperationCpltCallback could be implemented in the user file
+  */
+}
+
+/**
+* @brief  Error callback.
+* @param  hpka PKA handle
+* @retval None
+*/
+WEAK_FUNCTION(void HAL_PKA_ErrorCallback(PKA_HandleTypeDef *hpka))
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hpka);
+  
+  /* NOTE : This function should not be modified, when the callback is needed,
+  the HAL_PKA_ErrorCallback could be implemented in the user file
+  */
+}
+
+/**
+* @}
+*/
+
+/** @defgroup PKA_Exported_Functions_Group3 Peripheral State and Error functions
+*  @brief   Peripheral State and Error functions
+*
+@verbatim
+===============================================================================
+##### Peripheral State and Error functions #####
+===============================================================================
+[..]
+This subsection permit to get in run-time the status of the peripheral.
+
+@endverbatim
+* @{
+*/
+
+/**
+* @brief  Return the PKA handle state.
+* @param  hpka PKA handle
+* @retval HAL status
+*/
+HAL_PKA_StateTypeDef HAL_PKA_GetState(PKA_HandleTypeDef *hpka)
+{
+  /* Return PKA handle state */
+  return hpka->State;
+}
+
+/**
+* @brief  Return the PKA error code.
+* @param  hpka PKA handle
+* @retval PKA error code
+*/
+uint32_t HAL_PKA_GetError(PKA_HandleTypeDef *hpka)
+{
+  return hpka->ErrorCode;
+}
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/** @addtogroup PKA_Private_Functions
+* @{
+*/
+
+/**
+* @brief  Do the point multiplication on the content of the PKA RAM.
+* @retval None
+*/
+void PKA_Compute(void)
+{
+  uint32_t point[2U * P256_SW_WORDS];
+  uint32_t result[2U * P256_SW_WORDS];
+  uint8_t idx;
+  
+  for (idx = 0; idx < P256_SW_WORDS; idx++)
+  {
+    point[idx] = PKA_SW_RAM.PointX[idx];
+    point[P256_SW_WORDS + idx] = PKA_SW_RAM.PointY[idx];
+  }
+  
+  /* As the PKA, report an error if the point is not on the curve: the coordinates are not modified */
+  if (P256_SW_PointMul(result, PKA_SW_RAM.K, point) != P256_SW_SUCCESS)
+  {
+    PKA_SW_RAM.KpError = 1U;
+    return;
+  }
+  
+  PKA_SW_RAM.KpError = 0U;
+  for (idx = 0; idx < P256_SW_WORDS; idx++)
+  {
+    PKA_SW_RAM.PointX[idx] = result[idx];
+    PKA_SW_RAM.PointY[idx] = result[P256_SW_WORDS + idx];
+  }
+}
+
+/**
+* @brief  Return a hal error code based on the result of the operation.
+* @param  hpka PKA handle
+* @retval error code
+*/
+uint32_t PKA_CheckError(PKA_HandleTypeDef *hpka)
+{
+  uint32_t err = HAL_PKA_ERROR_NONE;
+  
+  UNUSED(hpka);
+  
+  /* If error output result is different from 0, operation need to be repeated */
+  if (PKA_SW_RAM.KpError != 0UL)
+  {
+    err |= HAL_PKA_ERROR_OPERATION;
+  }
+  
+  return err;
+}
+
+/**
+* @brief  Internal Utility for PKA key range check
+* @param  a: pka key
+*         b: reference key
+*         bufferSize: key size
+* @retval check result 
+*/
+static int rev_memcmp(uint8_t *a, const uint8_t *b, uint8_t  bufferSize)
+{
+  uint_fast8_t i = bufferSize;
+  int retval = 0;
+  
+  do
+  {
+    i--;
+    retval = (int)a[i] - (int)b[i];
+    if (retval !=0)
+    {
+      break;
+    }
+  } while (i != 0U);
+  
+  return retval;
+}
+
+
+/**
+* @brief  Write the PKA RAM with the input data.
+* @param  dataType: select the region of PKA RAM to write:
+*         @arg PKA_DATA_SK is the K value
+*         @arg PKA_DATA_PCX is the point X coordinate
+*         @arg PKA_DATA_PCY is the point Y coordinate
+* @retval Status
+*/
+uint32_t PKA_SetData(uint8_t dataType, uint32_t* srcData)
+{
+  const uint8_t P256_P_LE[32] = {0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0xff,0xff,0xff,0xff}; 
+  const uint8_t BLE_P256_ABELIAN_ORDER_R_LE[32] = {0x51,0x25,0x63,0xFC,0xC2,0xCA,0xB9,0xF3,0x84,0x9E,0x17,0xA7,0xAD,0xFA,0xE6,0xBC,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0xFF};
+  uint32_t *StartAddress = NULL;
+  uint8_t idx;
+  uint32_t err = HAL_PKA_ERROR_NONE;
+  
+  if (dataType == PKA_DATA_SK) {
+    if (rev_memcmp((uint8_t *) srcData, (uint8_t *)BLE_P256_ABELIAN_ORDER_R_LE, 32) >= 0) {
+      err |= HAL_PKA_ERROR_DATA_SK;
+    }
+    StartAddress = PKA_SW_RAM.K;
+  }
+  
+  else if (dataType == PKA_DATA_PCX) {
+    if (rev_memcmp((uint8_t *) srcData, (uint8_t *)P256_P_LE, 32) >= 0) {
+      err |= HAL_PKA_ERROR_DATA_PCX;
+    }
+    StartAddress = PKA_SW_RAM.PointX;
+  }
+  
+  else if (dataType == PKA_DATA_PCY) {
+    if (rev_memcmp((uint8_t *) srcData, (uint8_t *)P256_P_LE, 32) >= 0) {
+      err |= HAL_PKA_ERROR_DATA_PCY;
+    }
+    StartAddress = PKA_SW_RAM.PointY;
+  }
+  else 
+  {
+    err |= HAL_PKA_ERROR_OPERATION;
+    return err;
+  }
+  
+  /* Write the source data to target PKA RAM address. */
+  for (idx = 0; idx<8; idx++)
+  {
+    StartAddress[idx] = srcData[idx];
+  }
+  
+  /* A 9th word of zeros must be added */
+  StartAddress[8] = 0x00000000;
+  
+  return err;
+}
+
+/**
+* @brief  Run the jobs of the queue until it is empty.
+* @note   JobRunning stays set while the queue is run, so that the jobs queued
+*         by a job callback are run by this loop and not by a nested call.
+* @param  hpka PKA handle
+* @retval None
+*/
+static void PKA_Queue_Start(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job;
+  uint32_t running;
+  
+  ATOMIC_SECTION_BEGIN();
+  running = hpka->JobRunning;
+  hpka->JobRunning = 1UL;
+  ATOMIC_SECTION_END();
+  
+  if (running != 0UL)
+  {
+    return;
+  }
+  
+  while (((job = hpka->JobHead) != NULL) && (hpka->State == HAL_PKA_STATE_READY))
+  {
+    job->StartTick = HAL_GetTick();
+    
+    /* Do the computation, the error code of the handle is set as at the end of the hardware operation */
+    (void)HAL_PKA_StartProc(hpka, job->K, HAL_MAX_DELAY, job->Point);
+    
+    PKA_Queue_Complete(hpka);
+  }
+  
+  hpka->JobRunning = 0UL;
+}
+
+/**
+* @brief  Fetch the result of the job in progress, update the counters,
+*         remove the job from the queue and call its callback.
+* @param  hpka PKA handle
+* @retval None
+*/
+static void PKA_Queue_Complete(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job = hpka->JobHead;
+  PKA_JobStatsTypeDef *stats = &hpka->QueueStats.Jobs;
+  uint32_t tick = HAL_GetTick();
+  uint32_t time;
+  
+  job->ErrorCode = hpka->ErrorCode | PKA_CheckError(hpka);
+  
+  if (job->ErrorCode == HAL_PKA_ERROR_NONE)
+  {
+    /* Move the result to the location indicated in the job */
+    if (job->Result != NULL)
+    {
+      HAL_PKA_GetResult(hpka, PKA_DATA_PCX, (uint8_t *)&job->Result[0]);
+      HAL_PKA_GetResult(hpka, PKA_DATA_PCY, (uint8_t *)&job->Result[8]);
+    }
+  }
+  else
+  {
+    stats->Errors++;
+  }
+  
+  stats->Count++;
+  time = tick - job->StartTick;
+  stats->TotalTime += time;
+  if (time > stats->MaxTime)
+  {
+    stats->MaxTime = time;
+  }
+  time = tick - job->EnqueueTick;
+  stats->TotalLatency += time;
+  if (time > stats->MaxLatency)
+  {
+    stats->MaxLatency = time;
+  }
+  
+  /* Remove the job from the queue */
+  ATOMIC_SECTION_BEGIN();
+  hpka->JobHead = job->Next;
+  if (hpka->JobHead == NULL)
+  {
+    hpka->JobTail = NULL;
+  }
+  hpka->QueueStats.Depth--;
+  job->Pending = 0UL;
+  ATOMIC_SECTION_END();
+  
+  /* The job can be queued again from its callback */
+  if (job->Callback != NULL)
+  {
+    job->Callback(job);
+  }
+}
+
+/**
+* @brief  Remove all the jobs from the queue. Their callback is called with
+*         the HAL_PKA_ERROR_ABORTED error code.
+* @param  hpka PKA handle
+* @retval None
+*/
+static void PKA_Queue_Flush(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job;
+  PKA_JobTypeDef *next;
+  
+  ATOMIC_SECTION_BEGIN();
+  job = hpka->JobHead;
+  hpka->JobHead = NULL;
+  hpka->JobTail = NULL;
+  hpka->QueueStats.Depth = 0UL;
+  ATOMIC_SECTION_END();
+  
+  while (job != NULL)
+  {
+    next = job->Next;
+    job->ErrorCode = HAL_PKA_ERROR_ABORTED;
+    job->Pending = 0UL;
+    if (job->Callback != NULL)
+    {
+      job->Callback(job);
+    }
+    job = next;
+  }
+}
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif /* defined(PKA) && defined(HAL_PKA_MODULE_ENABLED) */
+
+/**
+* @}
+*/
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -164,6 +164,9 @@ HAL_StatusTypeDef PKA_PollEndOfOperation(PKA_HandleTypeDef *hpka, uint32_t Timeo
 uint32_t PKA_CheckError(PKA_HandleTypeDef *hpka);
 static int rev_memcmp(uint8_t *a, const uint8_t *b, uint8_t  bufferSize);
 uint32_t PKA_SetData(uint8_t dataType, uint32_t* srcData);
+static void PKA_Queue_Start(PKA_HandleTypeDef *hpka);
+static void PKA_Queue_Complete(PKA_HandleTypeDef *hpka);
+static void PKA_Queue_Flush(PKA_HandleTypeDef *hpka);
 /**
 * @}
 */
@@ -249,6 +252,13 @@ HAL_StatusTypeDef HAL_PKA_Init(PKA_HandleTypeDef *hpka)
     /* Initialize the error code */
     hpka->ErrorCode = HAL_PKA_ERROR_NONE;
     
+    /* Initialize the job queue */
+    hpka->JobHead = NULL;
+    hpka->JobTail = NULL;
+    hpka->JobRunning = 0UL;
+    hpka->QueueStats.Depth = 0UL;
+    HAL_PKA_ResetQueueStats(hpka);
+    
     /* Set the state to ready */
     hpka->State = HAL_PKA_STATE_READY;
   }
@@ -286,6 +296,9 @@ HAL_StatusTypeDef HAL_PKA_DeInit(PKA_HandleTypeDef *hpka)
     SET_BIT(hpka->Instance->ISR, PKA_ISR_PROC_END | PKA_ISR_RAM_ERR | PKA_ISR_ADD_ERR);
     CLEAR_BIT(hpka->Instance->ISR, PKA_ISR_PROC_END | PKA_ISR_RAM_ERR | PKA_ISR_ADD_ERR);
     
+    /* Drop the queued jobs */
+    PKA_Queue_Flush(hpka);
+    
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
     if (hpka->MspDeInitCallback == NULL)
     {
@@ -546,6 +559,18 @@ To stop any operation in interrupt mode, use HAL_PKA_Abort().
 (++) HAL_PKA_StartProc_IT();
 (++) HAL_PKA_Abort();
 
+(#) Job queue functions are :
+
+(++) HAL_PKA_Enqueue() adds a PKA_JobTypeDef to the queue and returns immediatly,
+even if the PKA is running another job. HAL_PKA_IRQHandler() copies the result
+of a completed job in its Result buffer, calls the job callback and starts the
+next job of the queue. The ErrorCode field of the job is valid once the callback
+is called. The PKA interrupt must be enabled.
+(++) HAL_PKA_GetQueueDepth(), HAL_PKA_GetQueueStats() and HAL_PKA_ResetQueueStats()
+monitor the queue.
+(++) Blocking and interrupt mode operations must not be started while the queue
+is not empty.
+
 @endverbatim
 * @{
 */
@@ -731,6 +756,9 @@ HAL_StatusTypeDef HAL_PKA_Abort(PKA_HandleTypeDef *hpka)
   /* Reset the state */
   hpka->State = HAL_PKA_STATE_READY;
   
+  /* Drop the queued jobs, the job in progress included */
+  PKA_Queue_Flush(hpka);
+  
   return err;
 }
 
@@ -781,7 +809,8 @@ void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka)
   }
   
   /* Trigger the error callback if an error is present */
-  if (hpka->ErrorCode != HAL_PKA_ERROR_NONE)
+  /* The errors of a queued job are reported in the job when it is completed */
+  if ((hpka->ErrorCode != HAL_PKA_ERROR_NONE) && (hpka->JobRunning == 0UL))
   {
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
     hpka->ErrorCallback(hpka);
@@ -799,12 +828,140 @@ void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka)
     /* Set the state to ready */
     hpka->State = HAL_PKA_STATE_READY;
     
+    if (hpka->JobRunning != 0UL)
+    {
+      /* Fetch the result of the job and remove it from the queue */
+      PKA_Queue_Complete(hpka);
+    }
+    else
+    {
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
-    hpka->OperationCpltCallback(hpka);
+      hpka->OperationCpltCallback(hpka);
 #else
-    HAL_PKA_OperationCpltCallback(hpka);
+      HAL_PKA_OperationCpltCallback(hpka);
 #endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+    }
+    
+    /* Start the next job of the queue, if any */
+    PKA_Queue_Start(hpka);
   }
+  else if ((hpka->JobRunning != 0UL) &&
+           ((hpka->ErrorCode & (HAL_PKA_ERROR_ADDRERR | HAL_PKA_ERROR_RAMERR)) != 0UL))
+  {
+    /* The job does not end with PROCEND after an address or RAM error: stop the
+       operation as HAL_PKA_Abort() does and complete the job with the error */
+    SET_BIT(hpka->Instance->CSR, PKA_CSR_SFT_RST);
+    CLEAR_BIT(hpka->Instance->CSR, PKA_CSR_SFT_RST);
+    SET_BIT(hpka->Instance->ISR, PKA_ISR_PROC_END);
+    CLEAR_BIT(hpka->Instance->ISR, PKA_ISR_PROC_END);
+    
+    hpka->State = HAL_PKA_STATE_READY;
+    
+    PKA_Queue_Complete(hpka);
+    
+    /* Start the next job of the queue, if any */
+    PKA_Queue_Start(hpka);
+  }
+}
+
+/**
+* @brief  Add a job to the PKA queue. The job is started immediatly if the PKA
+*         is idle, otherwise it is started by HAL_PKA_IRQHandler() when the
+*         previous jobs are completed.
+* @note   The PKA interrupt must be enabled.
+* @param  hpka PKA handle
+* @param  job Job to run. The job and its buffers must remain valid until its
+*         callback is called.
+* @retval HAL status
+*/
+HAL_StatusTypeDef HAL_PKA_Enqueue(PKA_HandleTypeDef *hpka, PKA_JobTypeDef *job)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+  
+  if ((job == NULL) || (job->K == NULL) || (hpka->State == HAL_PKA_STATE_RESET))
+  {
+    return HAL_ERROR;
+  }
+  
+  ATOMIC_SECTION_BEGIN();
+  
+  /* A job can be in the queue only once */
+  if (job->Pending != 0UL)
+  {
+    err = HAL_ERROR;
+  }
+  else
+  {
+    job->Pending = 1UL;
+    job->ErrorCode = HAL_PKA_ERROR_NONE;
+    job->EnqueueTick = HAL_GetTick();
+    job->Next = NULL;
+    
+    if (hpka->JobTail == NULL)
+    {
+      hpka->JobHead = job;
+    }
+    else
+    {
+      hpka->JobTail->Next = job;
+    }
+    hpka->JobTail = job;
+    
+    hpka->QueueStats.Depth++;
+    if (hpka->QueueStats.Depth > hpka->QueueStats.MaxDepth)
+    {
+      hpka->QueueStats.MaxDepth = hpka->QueueStats.Depth;
+    }
+    
+    PKA_Queue_Start(hpka);
+  }
+  
+  ATOMIC_SECTION_END();
+  
+  return err;
+}
+
+/**
+* @brief  Return the number of jobs in the queue, the job in progress included.
+* @param  hpka PKA handle
+* @retval Queue depth
+*/
+uint32_t HAL_PKA_GetQueueDepth(PKA_HandleTypeDef *hpka)
+{
+  return hpka->QueueStats.Depth;
+}
+
+/**
+* @brief  Retrieve the queue depth and the job counters.
+* @param  hpka PKA handle
+* @param  stats Copy of the counters
+* @retval None
+*/
+void HAL_PKA_GetQueueStats(PKA_HandleTypeDef *hpka, PKA_QueueStatsTypeDef *stats)
+{
+  ATOMIC_SECTION_BEGIN();
+  *stats = hpka->QueueStats;
+  ATOMIC_SECTION_END();
+}
+
+/**
+* @brief  Clear the job counters. The maximum depth restarts from the current depth.
+* @param  hpka PKA handle
+* @retval None
+*/
+void HAL_PKA_ResetQueueStats(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobStatsTypeDef *stats = &hpka->QueueStats.Jobs;
+  
+  ATOMIC_SECTION_BEGIN();
+  hpka->QueueStats.MaxDepth = hpka->QueueStats.Depth;
+  stats->Count = 0UL;
+  stats->Errors = 0UL;
+  stats->TotalTime = 0UL;
+  stats->MaxTime = 0UL;
+  stats->TotalLatency = 0UL;
+  stats->MaxLatency = 0UL;
+  ATOMIC_SECTION_END();
 }
 
 /**
@@ -1019,6 +1176,122 @@ uint32_t PKA_SetData(uint8_t dataType, uint32_t* srcData)
   return err;
 }
 
+/**
+* @brief  Start the job at the head of the queue if the PKA is idle.
+* @param  hpka PKA handle
+* @retval None
+*/
+static void PKA_Queue_Start(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job;
+  
+  ATOMIC_SECTION_BEGIN();
+  job = hpka->JobHead;
+  if ((job != NULL) && (hpka->JobRunning == 0UL) && (hpka->State == HAL_PKA_STATE_READY))
+  {
+    hpka->JobRunning = 1UL;
+    job->StartTick = HAL_GetTick();
+    
+    /* Start the operation */
+    (void)HAL_PKA_StartProc_IT(hpka, job->K, 0UL, job->Point);
+  }
+  ATOMIC_SECTION_END();
+}
+
+/**
+* @brief  Fetch the result of the job in progress, update the counters,
+*         remove the job from the queue and call its callback.
+* @param  hpka PKA handle
+* @retval None
+*/
+static void PKA_Queue_Complete(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job = hpka->JobHead;
+  PKA_JobStatsTypeDef *stats = &hpka->QueueStats.Jobs;
+  uint32_t tick = HAL_GetTick();
+  uint32_t time;
+  
+  job->ErrorCode = hpka->ErrorCode | PKA_CheckError(hpka);
+  
+  if (job->ErrorCode == HAL_PKA_ERROR_NONE)
+  {
+    /* Move the result to the location indicated in the job */
+    if (job->Result != NULL)
+    {
+      HAL_PKA_GetResult(hpka, PKA_DATA_PCX, (uint8_t *)&job->Result[0]);
+      HAL_PKA_GetResult(hpka, PKA_DATA_PCY, (uint8_t *)&job->Result[8]);
+    }
+  }
+  else
+  {
+    stats->Errors++;
+  }
+  
+  stats->Count++;
+  time = tick - job->StartTick;
+  stats->TotalTime += time;
+  if (time > stats->MaxTime)
+  {
+    stats->MaxTime = time;
+  }
+  time = tick - job->EnqueueTick;
+  stats->TotalLatency += time;
+  if (time > stats->MaxLatency)
+  {
+    stats->MaxLatency = time;
+  }
+  
+  /* Remove the job from the queue */
+  ATOMIC_SECTION_BEGIN();
+  hpka->JobHead = job->Next;
+  if (hpka->JobHead == NULL)
+  {
+    hpka->JobTail = NULL;
+  }
+  hpka->QueueStats.Depth--;
+  hpka->JobRunning = 0UL;
+  job->Pending = 0UL;
+  ATOMIC_SECTION_END();
+  
+  /* The job can be queued again from its callback */
+  if (job->Callback != NULL)
+  {
+    job->Callback(job);
+  }
+}
+
+/**
+* @brief  Remove all the jobs from the queue. Their callback is called with
+*         the HAL_PKA_ERROR_ABORTED error code.
+* @param  hpka PKA handle
+* @retval None
+*/
+static void PKA_Queue_Flush(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job;
+  PKA_JobTypeDef *next;
+  
+  ATOMIC_SECTION_BEGIN();
+  job = hpka->JobHead;
+  hpka->JobHead = NULL;
+  hpka->JobTail = NULL;
+  hpka->JobRunning = 0UL;
+  hpka->QueueStats.Depth = 0UL;
+  ATOMIC_SECTION_END();
+  
+  while (job != NULL)
+  {
+    next = job->Next;
+    job->ErrorCode = HAL_PKA_ERROR_ABORTED;
+    job->Pending = 0UL;
+    if (job->Callback != NULL)
+    {
+      job->Callback(job);
+    }
+    job = next;
+  }
+}
+
 /**
 * @}
 */
@@ -161,6 +161,51 @@
       (+) When an error is encountered, the callback HAL_PKA_ErrorCallback is called.
       (+) To stop any operation in interrupt mode, use HAL_PKA_Abort().
 
+    *** Curve and modulus contexts ***
+    ===================================
+    [..]
+      (+) When several operations use the same curve or the same modulus, the
+          parameters can be converted once to the PKA RAM representation:
+      (++) HAL_PKA_CurveInit() fills a PKA_CurveTypeDef with the curve parameters
+           and the Montgomery parameter of its modulus.
+      (++) HAL_PKA_ModulusInit() fills a PKA_ModulusTypeDef with a modulus and its
+           Montgomery parameter.
+      (+) The operations using a context only convert the per-call operands:
+      (++) HAL_PKA_ModExpCtx(), HAL_PKA_ModExpCtx_IT(), then HAL_PKA_ModExp_GetResult().
+      (++) HAL_PKA_ECDSASignCtx(), HAL_PKA_ECDSASignCtx_IT(), then HAL_PKA_ECDSASign_GetResult().
+      (++) HAL_PKA_ECDSAVerifCtx(), HAL_PKA_ECDSAVerifCtx_IT(), then HAL_PKA_ECDSAVerif_IsValidSignature().
+      (++) HAL_PKA_ECCMulCtx(), HAL_PKA_ECCMulCtx_IT(), then HAL_PKA_ECCMul_GetResult().
+      (+) The maximum sizes of the contexts are set by HAL_PKA_CURVE_MAX_SIZE and
+          HAL_PKA_MODULUS_MAX_SIZE.
+      (+) The contexts are only available on BlueNRG-LPS. The BlueNRG-LP PKA only
+          computes the P-256 scalar multiplication and has no curve or modulus to load.
+
+    *** Batch ECDSA verification ***
+    ===================================
+    [..]
+      (+) HAL_PKA_ECDSAVerifBatch() verifies an array of signatures made with the
+          same curve context and a set of public keys, in blocking mode.
+      (+) The curve parameters and the public key are loaded in the PKA RAM for each
+          signature, as the PKA RAM content is not kept between two operations.
+      (+) The operands of the next signature are converted while the PKA verifies
+          the current one.
+      (+) The result is a bitmap with one bit per signature, set if the signature
+          is valid.
+
+    *** Job queue ***
+    ===================================
+    [..]
+      (+) Fill a PKA_JobTypeDef with the operation, its input information, its
+          output buffers and an optional completion callback.
+      (+) Call HAL_PKA_Enqueue(). The function returns immediatly, even if the PKA
+          is running another operation.
+      (+) HAL_PKA_IRQHandler fetches the results of a completed job into its output
+          buffers, calls the job callback and starts the next job of the queue.
+      (+) The ErrorCode and Result fields of the job are valid once the callback is called.
+      (+) Use HAL_PKA_GetQueueDepth() and HAL_PKA_GetQueueStats() to monitor the queue.
+      (+) Blocking and interrupt mode operations must not be started while the queue
+          is not empty.
+
     *** Utilities ***
     ===================================
     [..]
@@ -300,6 +345,15 @@ void PKA_ModRed_Set(PKA_HandleTypeDef *hpka, PKA_ModRedInTypeDef *in);
 void PKA_ModInv_Set(PKA_HandleTypeDef *hpka, PKA_ModInvInTypeDef *in);
 void PKA_MontgomeryParam_Set(PKA_HandleTypeDef *hpka, const uint32_t size, const uint8_t *pOp1);
 void PKA_ARI_Set(PKA_HandleTypeDef *hpka, const uint32_t size, const uint32_t *pOp1, const uint32_t *pOp2, const uint8_t *pOp3);
+void PKA_ModExpCtx_Set(PKA_HandleTypeDef *hpka, PKA_ModExpCtxInTypeDef *in);
+void PKA_ECDSASignCtx_Set(PKA_HandleTypeDef *hpka, PKA_ECDSASignCtxInTypeDef *in);
+void PKA_ECDSAVerifCtx_Set(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifCtxInTypeDef *in);
+void PKA_ECDSAVerifCurve_Set(const PKA_CurveTypeDef *curve);
+uint32_t PKA_ECDSAVerifBatch_Next(PKA_ECDSAVerifBatchInTypeDef *in, uint32_t index);
+void PKA_ECCMulCtx_Set(PKA_HandleTypeDef *hpka, PKA_ECCMulCtxInTypeDef *in);
+void PKA_Queue_Start(PKA_HandleTypeDef *hpka);
+void PKA_Queue_Complete(PKA_HandleTypeDef *hpka);
+void PKA_Queue_Flush(PKA_HandleTypeDef *hpka);
 /**
   * @}
   */
@@ -380,6 +434,13 @@ HAL_StatusTypeDef HAL_PKA_Init(PKA_HandleTypeDef *hpka)
     /* Initialize the error code */
     hpka->ErrorCode = HAL_PKA_ERROR_NONE;
 
+    /* Initialize the job queue */
+    hpka->JobHead = NULL;
+    hpka->JobTail = NULL;
+    hpka->JobRunning = 0UL;
+    hpka->QueueStats.Depth = 0UL;
+    HAL_PKA_ResetQueueStats(hpka);
+
     /* Set the state to ready */
     hpka->State = HAL_PKA_STATE_READY;
   }
@@ -416,6 +477,9 @@ HAL_StatusTypeDef HAL_PKA_DeInit(PKA_HandleTypeDef *hpka)
     /* Reset any pending flag */
     SET_BIT(hpka->Instance->CLRFR, PKA_CLRFR_PROCENDFC | PKA_CLRFR_RAMERRFC | PKA_CLRFR_ADDRERRFC);
 
+    /* Drop the queued jobs */
+    PKA_Queue_Flush(hpka);
+
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
     if (hpka->MspDeInitCallback == NULL)
     {
@@ -704,6 +768,14 @@ HAL_StatusTypeDef HAL_PKA_UnRegisterCallback(PKA_HandleTypeDef *hpka, HAL_PKA_Ca
         (++) HAL_PKA_MontgomeryParam()
         (++) HAL_PKA_MontgomeryParam_GetResult();
 
+        (++) HAL_PKA_CurveInit()
+        (++) HAL_PKA_ModulusInit()
+        (++) HAL_PKA_ModExpCtx()
+        (++) HAL_PKA_ECDSASignCtx()
+        (++) HAL_PKA_ECDSAVerifCtx()
+        (++) HAL_PKA_ECCMulCtx()
+        (++) HAL_PKA_ECDSAVerifBatch()
+
     (#) No-Blocking mode functions with Interrupt are :
 
         (++) HAL_PKA_ModExp_IT();
@@ -740,6 +812,11 @@ HAL_StatusTypeDef HAL_PKA_UnRegisterCallback(PKA_HandleTypeDef *hpka, HAL_PKA_Ca
         (++) HAL_PKA_MontgomeryParam_IT();
         (++) HAL_PKA_MontgomeryParam_GetResult();
 
+        (++) HAL_PKA_ModExpCtx_IT();
+        (++) HAL_PKA_ECDSASignCtx_IT();
+        (++) HAL_PKA_ECDSAVerifCtx_IT();
+        (++) HAL_PKA_ECCMulCtx_IT();
+
         (++) HAL_PKA_Abort();
 
 @endverbatim
@@ -1430,6 +1507,366 @@ void HAL_PKA_MontgomeryParam_GetResult(PKA_HandleTypeDef *hpka, uint32_t *pRes)
   PKA_Memcpy_u32_to_u32(pRes, &PKA_RAM->RAM[PKA_MONTGOMERY_PARAM_OUT_PARAMETER], size);
 }
 
+/**
+  * @brief  Convert the parameters of a curve to the PKA RAM representation and
+  *         compute the Montgomery parameter of its modulus in blocking mode.
+  * @param  hpka PKA handle
+  * @param  curve Curve context to fill
+  * @param  in Curve parameters
+  * @param  Timeout Timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_CurveInit(PKA_HandleTypeDef *hpka, PKA_CurveTypeDef *curve, PKA_CurveInTypeDef *in, uint32_t Timeout)
+{
+  PKA_MontgomeryParamInTypeDef param;
+  HAL_StatusTypeDef err;
+  uint32_t index;
+
+  if ((in->modulusSize == 0UL) || (in->modulusSize > HAL_PKA_CURVE_MAX_SIZE) ||
+      (in->primeOrderSize == 0UL) || (in->primeOrderSize > HAL_PKA_CURVE_MAX_SIZE))
+  {
+    return HAL_ERROR;
+  }
+
+  for (index = 0UL; index < HAL_PKA_CURVE_MAX_WORDS; index++)
+  {
+    curve->montgomeryParam[index] = 0UL;
+  }
+
+  curve->primeOrderSize = in->primeOrderSize;
+  curve->modulusSize = in->modulusSize;
+  curve->primeOrderNbBits = PKA_GetOptBitSize_u8(in->primeOrderSize, *(in->primeOrder));
+  curve->modulusNbBits = PKA_GetOptBitSize_u8(in->modulusSize, *(in->modulus));
+  curve->coefSign = in->coefSign;
+
+  /* Apply the byte reordering once */
+  PKA_Memcpy_u8_to_u32(curve->coef, in->coef, in->modulusSize);
+  PKA_Memcpy_u8_to_u32(curve->modulus, in->modulus, in->modulusSize);
+  PKA_Memcpy_u8_to_u32(curve->basePointX, in->basePointX, in->modulusSize);
+  PKA_Memcpy_u8_to_u32(curve->basePointY, in->basePointY, in->modulusSize);
+  PKA_Memcpy_u8_to_u32(curve->primeOrder, in->primeOrder, in->primeOrderSize);
+
+  /* Compute the Montgomery parameter of the modulus */
+  param.size = in->modulusSize;
+  param.pOp1 = in->modulus;
+  err = HAL_PKA_MontgomeryParam(hpka, &param, Timeout);
+  if (err == HAL_OK)
+  {
+    HAL_PKA_MontgomeryParam_GetResult(hpka, curve->montgomeryParam);
+  }
+
+  return err;
+}
+
+/**
+  * @brief  Convert a modulus to the PKA RAM representation and compute its
+  *         Montgomery parameter in blocking mode.
+  * @param  hpka PKA handle
+  * @param  modulus Modulus context to fill
+  * @param  pMod Pointer to modulus (Array of OpSize elements)
+  * @param  OpSize Number of element in pMod array
+  * @param  Timeout Timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ModulusInit(PKA_HandleTypeDef *hpka, PKA_ModulusTypeDef *modulus, const uint8_t *pMod, uint32_t OpSize, uint32_t Timeout)
+{
+  PKA_MontgomeryParamInTypeDef param;
+  HAL_StatusTypeDef err;
+  uint32_t index;
+
+  if ((OpSize == 0UL) || (OpSize > HAL_PKA_MODULUS_MAX_SIZE))
+  {
+    return HAL_ERROR;
+  }
+
+  for (index = 0UL; index < HAL_PKA_MODULUS_MAX_WORDS; index++)
+  {
+    modulus->montgomeryParam[index] = 0UL;
+  }
+
+  modulus->OpSize = OpSize;
+
+  /* Apply the byte reordering once */
+  PKA_Memcpy_u8_to_u32(modulus->modulus, pMod, OpSize);
+
+  /* Compute the Montgomery parameter of the modulus */
+  param.size = OpSize;
+  param.pOp1 = pMod;
+  err = HAL_PKA_MontgomeryParam(hpka, &param, Timeout);
+  if (err == HAL_OK)
+  {
+    HAL_PKA_MontgomeryParam_GetResult(hpka, modulus->montgomeryParam);
+  }
+
+  return err;
+}
+
+/**
+  * @brief  Modular exponentiation with a modulus context in blocking mode.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @param  Timeout Timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ModExpCtx(PKA_HandleTypeDef *hpka, PKA_ModExpCtxInTypeDef *in, uint32_t Timeout)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ModExpCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process(hpka, PKA_MODE_MODULAR_EXP, Timeout);
+}
+
+/**
+  * @brief  Modular exponentiation with a modulus context in non-blocking mode with Interrupt.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ModExpCtx_IT(PKA_HandleTypeDef *hpka, PKA_ModExpCtxInTypeDef *in)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ModExpCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process_IT(hpka, PKA_MODE_MODULAR_EXP);
+}
+
+/**
+  * @brief  Sign a message with a curve context in blocking mode.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @param  Timeout Timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECDSASignCtx(PKA_HandleTypeDef *hpka, PKA_ECDSASignCtxInTypeDef *in, uint32_t Timeout)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ECDSASignCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process(hpka, PKA_MODE_ECDSA_SIGNATURE, Timeout);
+}
+
+/**
+  * @brief  Sign a message with a curve context in non-blocking mode with Interrupt.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECDSASignCtx_IT(PKA_HandleTypeDef *hpka, PKA_ECDSASignCtxInTypeDef *in)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ECDSASignCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process_IT(hpka, PKA_MODE_ECDSA_SIGNATURE);
+}
+
+/**
+  * @brief  Verify the validity of a signature with a curve context in blocking mode.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @param  Timeout Timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECDSAVerifCtx(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifCtxInTypeDef *in, uint32_t Timeout)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ECDSAVerifCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process(hpka, PKA_MODE_ECDSA_VERIFICATION, Timeout);
+}
+
+/**
+  * @brief  Verify the validity of a signature with a curve context in non-blocking mode with Interrupt.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECDSAVerifCtx_IT(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifCtxInTypeDef *in)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ECDSAVerifCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process_IT(hpka, PKA_MODE_ECDSA_VERIFICATION);
+}
+
+/**
+  * @brief  ECC scalar multiplication with a curve context in blocking mode.
+  *         The Montgomery parameter of the context is loaded.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @param  Timeout Timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECCMulCtx(PKA_HandleTypeDef *hpka, PKA_ECCMulCtxInTypeDef *in, uint32_t Timeout)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ECCMulCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process(hpka, PKA_MODE_ECC_KP_PRIMITIVE, Timeout);
+}
+
+/**
+  * @brief  ECC scalar multiplication with a curve context in non-blocking mode with Interrupt.
+  *         The Montgomery parameter of the context is loaded.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECCMulCtx_IT(PKA_HandleTypeDef *hpka, PKA_ECCMulCtxInTypeDef *in)
+{
+  /* Set input parameter in PKA RAM */
+  PKA_ECCMulCtx_Set(hpka, in);
+
+  /* Start the operation */
+  return PKA_Process_IT(hpka, PKA_MODE_ECC_KP_PRIMITIVE);
+}
+
+/**
+  * @brief  Verify a batch of ECDSA signatures made with the same curve in blocking mode.
+  *         The curve parameters and the public key are loaded in the PKA RAM for each
+  *         item, nothing is expected to be kept in the PKA RAM between two verifications.
+  *         The operands of the next item are converted while the PKA verifies the
+  *         current one.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  * @param  validity Validity bitmap (Array of (in->itemNumber + 31) / 32 elements).
+  *         The bit i is set if the signature of the item i is valid. It is cleared if the
+  *         signature is not valid, if the key index is out of range or if the batch has
+  *         been stopped by an error before the item.
+  * @param  Timeout Timeout duration of each verification
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_ECDSAVerifBatch(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifBatchInTypeDef *in, uint32_t *validity, uint32_t Timeout)
+{
+  const PKA_CurveTypeDef *curve = in->curve;
+  const PKA_ECDSAVerifBatchItemTypeDef *item;
+  uint32_t modWords = (curve->modulusSize + 3UL) / 4UL;
+  uint32_t orderWords = (curve->primeOrderSize + 3UL) / 4UL;
+  uint32_t pubKeyX[HAL_PKA_CURVE_MAX_WORDS];
+  uint32_t pubKeyY[HAL_PKA_CURVE_MAX_WORDS];
+  uint32_t RSign[HAL_PKA_CURVE_MAX_WORDS];
+  uint32_t SSign[HAL_PKA_CURVE_MAX_WORDS];
+  uint32_t hash[HAL_PKA_CURVE_MAX_WORDS];
+  uint32_t index;
+  uint32_t next;
+  uint32_t tickstart;
+  HAL_StatusTypeDef err = HAL_OK;
+
+  if (hpka->State != HAL_PKA_STATE_READY)
+  {
+    return HAL_ERROR;
+  }
+
+  for (index = 0UL; index < ((in->itemNumber + 31UL) / 32UL); index++)
+  {
+    validity[index] = 0UL;
+  }
+
+  index = PKA_ECDSAVerifBatch_Next(in, 0UL);
+  if (index >= in->itemNumber)
+  {
+    return HAL_OK;
+  }
+
+  /* Set the state to busy */
+  hpka->State = HAL_PKA_STATE_BUSY;
+
+  /* Clear any pending error */
+  hpka->ErrorCode = HAL_PKA_ERROR_NONE;
+
+  /* Set the mode and deactivate the interrupts */
+  MODIFY_REG(hpka->Instance->CR, PKA_CR_MODE | PKA_CR_PROCENDIE | PKA_CR_RAMERRIE | PKA_CR_ADDRERRIE, PKA_MODE_ECDSA_VERIFICATION << PKA_CR_MODE_Pos);
+
+  /* Convert the operands of the first item */
+  item = &in->items[index];
+  PKA_Memcpy_u8_to_u32(pubKeyX, in->pPubKeyCurvePtX[item->keyIndex], curve->modulusSize);
+  PKA_Memcpy_u8_to_u32(pubKeyY, in->pPubKeyCurvePtY[item->keyIndex], curve->modulusSize);
+  PKA_Memcpy_u8_to_u32(RSign, item->RSign, curve->primeOrderSize);
+  PKA_Memcpy_u8_to_u32(SSign, item->SSign, curve->primeOrderSize);
+  PKA_Memcpy_u8_to_u32(hash, item->hash, curve->primeOrderSize);
+
+  while (index < in->itemNumber)
+  {
+    /* Move the curve parameters to PKA RAM */
+    PKA_ECDSAVerifCurve_Set(curve);
+
+    /* Move the converted operands to PKA RAM */
+    PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_X], pubKeyX, modWords);
+    __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_X + modWords);
+
+    PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_Y], pubKeyY, modWords);
+    __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_Y + modWords);
+
+    PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_SIGNATURE_R], RSign, orderWords);
+    __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_SIGNATURE_R + orderWords);
+
+    PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_SIGNATURE_S], SSign, orderWords);
+    __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_SIGNATURE_S + orderWords);
+
+    PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_HASH_E], hash, orderWords);
+    __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_HASH_E + orderWords);
+
+    /* Start the computation */
+    tickstart = HAL_GetTick();
+    hpka->Instance->CR |= PKA_CR_START;
+
+    /* Convert the operands of the next item while the PKA computes */
+    next = PKA_ECDSAVerifBatch_Next(in, index + 1UL);
+    if (next < in->itemNumber)
+    {
+      item = &in->items[next];
+      PKA_Memcpy_u8_to_u32(pubKeyX, in->pPubKeyCurvePtX[item->keyIndex], curve->modulusSize);
+      PKA_Memcpy_u8_to_u32(pubKeyY, in->pPubKeyCurvePtY[item->keyIndex], curve->modulusSize);
+      PKA_Memcpy_u8_to_u32(RSign, item->RSign, curve->primeOrderSize);
+      PKA_Memcpy_u8_to_u32(SSign, item->SSign, curve->primeOrderSize);
+      PKA_Memcpy_u8_to_u32(hash, item->hash, curve->primeOrderSize);
+    }
+
+    /* Wait for the end of operation or timeout */
+    if (PKA_PollEndOfOperation(hpka, Timeout, tickstart) != HAL_OK)
+    {
+      /* Abort any ongoing operation */
+      CLEAR_BIT(hpka->Instance->CR, PKA_CR_EN);
+
+      hpka->ErrorCode |= HAL_PKA_ERROR_TIMEOUT;
+
+      /* Make ready for the next operation */
+      SET_BIT(hpka->Instance->CR, PKA_CR_EN);
+    }
+
+    /* Check error */
+    hpka->ErrorCode |= PKA_CheckError(hpka, PKA_MODE_ECDSA_VERIFICATION);
+
+    /* Clear all flags */
+    hpka->Instance->CLRFR |= (PKA_CLRFR_PROCENDFC | PKA_CLRFR_RAMERRFC | PKA_CLRFR_ADDRERRFC);
+
+    /* Stop the batch on the first error, the PKA RAM content is not guaranteed */
+    if (hpka->ErrorCode != HAL_PKA_ERROR_NONE)
+    {
+      err = HAL_ERROR;
+      break;
+    }
+
+    if (HAL_PKA_ECDSAVerif_IsValidSignature(hpka) == 1UL)
+    {
+      validity[index / 32UL] |= (1UL << (index % 32UL));
+    }
+
+    index = next;
+  }
+
+  /* Set the state to ready */
+  hpka->State = HAL_PKA_STATE_READY;
+
+  return err;
+}
+
 /**
   * @brief  Abort any ongoing operation.
   * @param  hpka PKA handle
@@ -1453,6 +1890,9 @@ HAL_StatusTypeDef HAL_PKA_Abort(PKA_HandleTypeDef *hpka)
   /* Reset the state */
   hpka->State = HAL_PKA_STATE_READY;
 
+  /* Drop the queued jobs, the job in progress included */
+  PKA_Queue_Flush(hpka);
+
   return err;
 }
 
@@ -1513,7 +1953,8 @@ void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka)
     }
   }
   /* Trigger the error callback if an error is present */
-  if (hpka->ErrorCode != HAL_PKA_ERROR_NONE)
+  /* The errors of a queued job are reported in the job when it is completed */
+  if ((hpka->ErrorCode != HAL_PKA_ERROR_NONE) && (hpka->JobRunning == 0UL))
   {
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
     hpka->ErrorCallback(hpka);
@@ -1531,14 +1972,148 @@ void HAL_PKA_IRQHandler(PKA_HandleTypeDef *hpka)
     /* Set the state to ready */
     hpka->State = HAL_PKA_STATE_READY;
 
+    if (hpka->JobRunning != 0UL)
+    {
+      /* Fetch the results of the job and remove it from the queue */
+      PKA_Queue_Complete(hpka);
+    }
+    else
+    {
 #if (USE_HAL_PKA_REGISTER_CALLBACKS == 1)
-    hpka->OperationCpltCallback(hpka);
+      hpka->OperationCpltCallback(hpka);
 #else
-    HAL_PKA_OperationCpltCallback(hpka);
+      HAL_PKA_OperationCpltCallback(hpka);
 #endif /* USE_HAL_PKA_REGISTER_CALLBACKS */
+    }
+
+    /* Start the next job of the queue, if any */
+    PKA_Queue_Start(hpka);
+  }
+  else if ((hpka->JobRunning != 0UL) &&
+           ((hpka->ErrorCode & (HAL_PKA_ERROR_ADDRERR | HAL_PKA_ERROR_RAMERR)) != 0UL))
+  {
+    /* The job does not end with PROCEND after an address or RAM error: stop the
+       operation as HAL_PKA_Abort() does and complete the job with the error */
+    CLEAR_BIT(hpka->Instance->CR, PKA_CR_EN);
+    SET_BIT(hpka->Instance->CR, PKA_CR_EN);
+    SET_BIT(hpka->Instance->CLRFR, PKA_CLRFR_PROCENDFC);
+
+    hpka->State = HAL_PKA_STATE_READY;
+
+    PKA_Queue_Complete(hpka);
+
+    /* Start the next job of the queue, if any */
+    PKA_Queue_Start(hpka);
   }
 }
 
+/**
+  * @brief  Add a job to the PKA queue. The job is started immediatly if the PKA
+  *         is idle, otherwise it is started by HAL_PKA_IRQHandler() when the
+  *         previous jobs are completed.
+  * @note   The PKA interrupt must be enabled.
+  * @param  hpka PKA handle
+  * @param  job Job to run. The job and its buffers must remain valid until its
+  *         callback is called.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PKA_Enqueue(PKA_HandleTypeDef *hpka, PKA_JobTypeDef *job)
+{
+  HAL_StatusTypeDef err = HAL_OK;
+
+  if ((job == NULL) || (job->In == NULL) || ((uint32_t)job->Operation >= HAL_PKA_JOB_OPERATION_NUMBER) ||
+      (hpka->State == HAL_PKA_STATE_RESET))
+  {
+    return HAL_ERROR;
+  }
+
+  ATOMIC_SECTION_BEGIN();
+
+  /* A job can be in the queue only once */
+  if (job->Pending != 0UL)
+  {
+    err = HAL_ERROR;
+  }
+  else
+  {
+    job->Pending = 1UL;
+    job->ErrorCode = HAL_PKA_ERROR_NONE;
+    job->Result = 0UL;
+    job->EnqueueTick = HAL_GetTick();
+    job->Next = NULL;
+
+    if (hpka->JobTail == NULL)
+    {
+      hpka->JobHead = job;
+    }
+    else
+    {
+      hpka->JobTail->Next = job;
+    }
+    hpka->JobTail = job;
+
+    hpka->QueueStats.Depth++;
+    if (hpka->QueueStats.Depth > hpka->QueueStats.MaxDepth)
+    {
+      hpka->QueueStats.MaxDepth = hpka->QueueStats.Depth;
+    }
+
+    PKA_Queue_Start(hpka);
+  }
+
+  ATOMIC_SECTION_END();
+
+  return err;
+}
+
+/**
+  * @brief  Return the number of jobs in the queue, the job in progress included.
+  * @param  hpka PKA handle
+  * @retval Queue depth
+  */
+uint32_t HAL_PKA_GetQueueDepth(PKA_HandleTypeDef *hpka)
+{
+  return hpka->QueueStats.Depth;
+}
+
+/**
+  * @brief  Retrieve the queue depth and the per-operation job counters.
+  * @param  hpka PKA handle
+  * @param  stats Copy of the counters
+  * @retval None
+  */
+void HAL_PKA_GetQueueStats(PKA_HandleTypeDef *hpka, PKA_QueueStatsTypeDef *stats)
+{
+  ATOMIC_SECTION_BEGIN();
+  *stats = hpka->QueueStats;
+  ATOMIC_SECTION_END();
+}
+
+/**
+  * @brief  Clear the job counters. The maximum depth restarts from the current depth.
+  * @param  hpka PKA handle
+  * @retval None
+  */
+void HAL_PKA_ResetQueueStats(PKA_HandleTypeDef *hpka)
+{
+  uint32_t index;
+  PKA_JobStatsTypeDef *stats;
+
+  ATOMIC_SECTION_BEGIN();
+  hpka->QueueStats.MaxDepth = hpka->QueueStats.Depth;
+  for (index = 0UL; index < HAL_PKA_JOB_OPERATION_NUMBER; index++)
+  {
+    stats = &hpka->QueueStats.Operation[index];
+    stats->Count = 0UL;
+    stats->Errors = 0UL;
+    stats->TotalTime = 0UL;
+    stats->MaxTime = 0UL;
+    stats->TotalLatency = 0UL;
+    stats->MaxLatency = 0UL;
+  }
+  ATOMIC_SECTION_END();
+}
+
 /**
   * @brief  Process completed callback.
   * @param  hpka PKA handle
@@ -1955,6 +2530,211 @@ HAL_StatusTypeDef PKA_Process_IT(PKA_HandleTypeDef *hpka, uint32_t mode)
   return err;
 }
 
+/**
+  * @brief  Start the job at the head of the queue if the PKA is idle.
+  * @param  hpka PKA handle
+  * @retval None
+  */
+void PKA_Queue_Start(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job = hpka->JobHead;
+  uint32_t mode;
+
+  if ((job == NULL) || (hpka->JobRunning != 0UL) || (hpka->State != HAL_PKA_STATE_READY))
+  {
+    return;
+  }
+
+  /* Set input parameter in PKA RAM */
+  switch (job->Operation)
+  {
+    case HAL_PKA_JOB_MODULAR_EXP:
+      PKA_ModExp_Set(hpka, (PKA_ModExpInTypeDef *)job->In);
+      mode = PKA_MODE_MODULAR_EXP;
+      break;
+    case HAL_PKA_JOB_MODULAR_EXP_FAST_MODE:
+      PKA_ModExpFastMode_Set(hpka, (PKA_ModExpFastModeInTypeDef *)job->In);
+      mode = PKA_MODE_MODULAR_EXP;
+      break;
+    case HAL_PKA_JOB_ECDSA_SIGNATURE:
+      PKA_ECDSASign_Set(hpka, (PKA_ECDSASignInTypeDef *)job->In);
+      mode = PKA_MODE_ECDSA_SIGNATURE;
+      break;
+    case HAL_PKA_JOB_ECDSA_VERIFICATION:
+      PKA_ECDSAVerif_Set(hpka, (PKA_ECDSAVerifInTypeDef *)job->In);
+      mode = PKA_MODE_ECDSA_VERIFICATION;
+      break;
+    case HAL_PKA_JOB_RSA_CRT_EXP:
+      PKA_RSACRTExp_Set(hpka, (PKA_RSACRTExpInTypeDef *)job->In);
+      mode = PKA_MODE_RSA_CRT_EXP;
+      break;
+    case HAL_PKA_JOB_POINT_CHECK:
+      PKA_PointCheck_Set(hpka, (PKA_PointCheckInTypeDef *)job->In);
+      mode = PKA_MODE_POINT_CHECK;
+      break;
+    case HAL_PKA_JOB_ECC_MUL:
+      PKA_ECCMul_Set(hpka, (PKA_ECCMulInTypeDef *)job->In);
+      mode = PKA_MODE_ECC_KP_PRIMITIVE;
+      break;
+    case HAL_PKA_JOB_ECC_MUL_FAST_MODE:
+      PKA_ECCMulFastMode_Set(hpka, (PKA_ECCMulFastModeInTypeDef *)job->In);
+      mode = PKA_MODE_ECC_KP_PRIMITIVE;
+      break;
+    case HAL_PKA_JOB_MODULAR_EXP_CTX:
+      PKA_ModExpCtx_Set(hpka, (PKA_ModExpCtxInTypeDef *)job->In);
+      mode = PKA_MODE_MODULAR_EXP;
+      break;
+    case HAL_PKA_JOB_ECDSA_SIGNATURE_CTX:
+      PKA_ECDSASignCtx_Set(hpka, (PKA_ECDSASignCtxInTypeDef *)job->In);
+      mode = PKA_MODE_ECDSA_SIGNATURE;
+      break;
+    case HAL_PKA_JOB_ECDSA_VERIFICATION_CTX:
+      PKA_ECDSAVerifCtx_Set(hpka, (PKA_ECDSAVerifCtxInTypeDef *)job->In);
+      mode = PKA_MODE_ECDSA_VERIFICATION;
+      break;
+    case HAL_PKA_JOB_ECC_MUL_CTX:
+      PKA_ECCMulCtx_Set(hpka, (PKA_ECCMulCtxInTypeDef *)job->In);
+      mode = PKA_MODE_ECC_KP_PRIMITIVE;
+      break;
+    default: /* HAL_PKA_JOB_MONTGOMERY_PARAM */
+      PKA_MontgomeryParam_Set(hpka, ((PKA_MontgomeryParamInTypeDef *)job->In)->size, ((PKA_MontgomeryParamInTypeDef *)job->In)->pOp1);
+      mode = PKA_MODE_MONTGOMERY_PARAM;
+      break;
+  }
+
+  hpka->JobRunning = 1UL;
+  job->StartTick = HAL_GetTick();
+
+  /* Start the operation */
+  (void)PKA_Process_IT(hpka, mode);
+}
+
+/**
+  * @brief  Fetch the results of the job in progress, update the counters,
+  *         remove the job from the queue and call its callback.
+  * @param  hpka PKA handle
+  * @retval None
+  */
+void PKA_Queue_Complete(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job = hpka->JobHead;
+  PKA_JobStatsTypeDef *stats = &hpka->QueueStats.Operation[job->Operation];
+  uint32_t tick = HAL_GetTick();
+  uint32_t time;
+
+  job->ErrorCode = hpka->ErrorCode;
+
+  if (job->ErrorCode == HAL_PKA_ERROR_NONE)
+  {
+    /* Move the result to the location indicated in the job */
+    switch (job->Operation)
+    {
+      case HAL_PKA_JOB_MODULAR_EXP:
+      case HAL_PKA_JOB_MODULAR_EXP_FAST_MODE:
+      case HAL_PKA_JOB_MODULAR_EXP_CTX:
+        if (job->Out != NULL)
+        {
+          HAL_PKA_ModExp_GetResult(hpka, (uint8_t *)job->Out);
+        }
+        break;
+      case HAL_PKA_JOB_ECDSA_SIGNATURE:
+      case HAL_PKA_JOB_ECDSA_SIGNATURE_CTX:
+        HAL_PKA_ECDSASign_GetResult(hpka, (PKA_ECDSASignOutTypeDef *)job->Out, (PKA_ECDSASignOutExtParamTypeDef *)job->OutExt);
+        break;
+      case HAL_PKA_JOB_ECDSA_VERIFICATION:
+      case HAL_PKA_JOB_ECDSA_VERIFICATION_CTX:
+        job->Result = HAL_PKA_ECDSAVerif_IsValidSignature(hpka);
+        break;
+      case HAL_PKA_JOB_RSA_CRT_EXP:
+        if (job->Out != NULL)
+        {
+          HAL_PKA_RSACRTExp_GetResult(hpka, (uint8_t *)job->Out);
+        }
+        break;
+      case HAL_PKA_JOB_POINT_CHECK:
+        job->Result = HAL_PKA_PointCheck_IsOnCurve(hpka);
+        break;
+      case HAL_PKA_JOB_ECC_MUL:
+      case HAL_PKA_JOB_ECC_MUL_FAST_MODE:
+      case HAL_PKA_JOB_ECC_MUL_CTX:
+        HAL_PKA_ECCMul_GetResult(hpka, (PKA_ECCMulOutTypeDef *)job->Out);
+        break;
+      default: /* HAL_PKA_JOB_MONTGOMERY_PARAM */
+        if (job->Out != NULL)
+        {
+          HAL_PKA_MontgomeryParam_GetResult(hpka, (uint32_t *)job->Out);
+        }
+        break;
+    }
+  }
+  else
+  {
+    stats->Errors++;
+  }
+
+  stats->Count++;
+  time = tick - job->StartTick;
+  stats->TotalTime += time;
+  if (time > stats->MaxTime)
+  {
+    stats->MaxTime = time;
+  }
+  time = tick - job->EnqueueTick;
+  stats->TotalLatency += time;
+  if (time > stats->MaxLatency)
+  {
+    stats->MaxLatency = time;
+  }
+
+  /* Remove the job from the queue */
+  hpka->JobHead = job->Next;
+  if (hpka->JobHead == NULL)
+  {
+    hpka->JobTail = NULL;
+  }
+  hpka->QueueStats.Depth--;
+  hpka->JobRunning = 0UL;
+  job->Pending = 0UL;
+
+  /* The job can be queued again from its callback */
+  if (job->Callback != NULL)
+  {
+    job->Callback(job);
+  }
+}
+
+/**
+  * @brief  Remove all the jobs from the queue. Their callback is called with
+  *         the HAL_PKA_ERROR_ABORTED error code.
+  * @param  hpka PKA handle
+  * @retval None
+  */
+void PKA_Queue_Flush(PKA_HandleTypeDef *hpka)
+{
+  PKA_JobTypeDef *job;
+  PKA_JobTypeDef *next;
+
+  ATOMIC_SECTION_BEGIN();
+  job = hpka->JobHead;
+  hpka->JobHead = NULL;
+  hpka->JobTail = NULL;
+  hpka->JobRunning = 0UL;
+  hpka->QueueStats.Depth = 0UL;
+  ATOMIC_SECTION_END();
+
+  while (job != NULL)
+  {
+    next = job->Next;
+    job->ErrorCode = HAL_PKA_ERROR_ABORTED;
+    job->Pending = 0UL;
+    if (job->Callback != NULL)
+    {
+      job->Callback(job);
+    }
+    job = next;
+  }
+}
+
 /**
   * @brief  Set input parameters.
   * @param  hpka PKA handle
@@ -2362,6 +3142,216 @@ void PKA_ARI_Set(PKA_HandleTypeDef *hpka, const uint32_t size, const uint32_t *p
   }
 }
 
+/**
+  * @brief  Set input parameters. Only the operands are converted, the modulus
+  *         and its Montgomery parameter are copied from the context.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  */
+void PKA_ModExpCtx_Set(PKA_HandleTypeDef *hpka, PKA_ModExpCtxInTypeDef *in)
+{
+  const PKA_ModulusTypeDef *modulus = in->modulus;
+  uint32_t words = (modulus->OpSize + 3UL) / 4UL;
+
+  /* Get the number of bit per operand */
+  PKA_RAM->RAM[PKA_MODULAR_EXP_IN_OP_NB_BITS] = PKA_GetBitSize_u8(modulus->OpSize);
+
+  /* Get the number of bit of the exponent */
+  PKA_RAM->RAM[PKA_MODULAR_EXP_IN_EXP_NB_BITS] = PKA_GetBitSize_u8(in->expSize);
+
+  /* Move the input parameters pOp1 to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_MODULAR_EXP_IN_EXPONENT_BASE], in->pOp1, modulus->OpSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_MODULAR_EXP_IN_EXPONENT_BASE + words);
+
+  /* Move the exponent to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_MODULAR_EXP_IN_EXPONENT], in->pExp, in->expSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_MODULAR_EXP_IN_EXPONENT + ((in->expSize + 3UL) / 4UL));
+
+  /* Move the modulus to PKA RAM */
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_MODULAR_EXP_IN_MODULUS], modulus->modulus, words);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_MODULAR_EXP_IN_MODULUS + words);
+
+  /* Move the Montgomery parameter to PKA RAM */
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_MODULAR_EXP_IN_MONTGOMERY_PARAM], modulus->montgomeryParam, words);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_MODULAR_EXP_IN_MONTGOMERY_PARAM + words);
+}
+
+/**
+  * @brief  Set input parameters. Only the operands are converted, the curve
+  *         parameters are copied from the context.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  */
+void PKA_ECDSASignCtx_Set(PKA_HandleTypeDef *hpka, PKA_ECDSASignCtxInTypeDef *in)
+{
+  const PKA_CurveTypeDef *curve = in->curve;
+  uint32_t modWords = (curve->modulusSize + 3UL) / 4UL;
+  uint32_t orderWords = (curve->primeOrderSize + 3UL) / 4UL;
+
+  /* Get the prime order n length */
+  PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_ORDER_NB_BITS] = curve->primeOrderNbBits;
+
+  /* Get the modulus p length */
+  PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_MOD_NB_BITS] = curve->modulusNbBits;
+
+  /* Get the coefficient a sign */
+  PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_A_COEFF_SIGN] = curve->coefSign;
+
+  /* Move the curve parameters to PKA RAM */
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_A_COEFF], curve->coef, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_A_COEFF + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_MOD_GF], curve->modulus, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_MOD_GF + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_INITIAL_POINT_X], curve->basePointX, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_INITIAL_POINT_X + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_INITIAL_POINT_Y], curve->basePointY, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_INITIAL_POINT_Y + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_ORDER_N], curve->primeOrder, orderWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_ORDER_N + orderWords);
+
+  /* Move the input parameters integer k to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_K], in->integer, curve->primeOrderSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_K + orderWords);
+
+  /* Move the input parameters hash of message z to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_HASH_E], in->hash, curve->primeOrderSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_HASH_E + orderWords);
+
+  /* Move the input parameters private key d to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_SIGN_IN_PRIVATE_KEY_D], in->privateKey, curve->primeOrderSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_SIGN_IN_PRIVATE_KEY_D + orderWords);
+}
+
+/**
+  * @brief  Set input parameters. Only the operands are converted, the curve
+  *         parameters are copied from the context.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  */
+void PKA_ECDSAVerifCtx_Set(PKA_HandleTypeDef *hpka, PKA_ECDSAVerifCtxInTypeDef *in)
+{
+  const PKA_CurveTypeDef *curve = in->curve;
+  uint32_t modWords = (curve->modulusSize + 3UL) / 4UL;
+  uint32_t orderWords = (curve->primeOrderSize + 3UL) / 4UL;
+
+  /* Move the curve parameters to PKA RAM */
+  PKA_ECDSAVerifCurve_Set(curve);
+
+  /* Move the input parameters public-key curve point Q coordinates to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_X], in->pPubKeyCurvePtX, curve->modulusSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_X + modWords);
+
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_Y], in->pPubKeyCurvePtY, curve->modulusSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_Y + modWords);
+
+  /* Move the input parameters signature part r and s to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_SIGNATURE_R], in->RSign, curve->primeOrderSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_SIGNATURE_R + orderWords);
+
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_SIGNATURE_S], in->SSign, curve->primeOrderSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_SIGNATURE_S + orderWords);
+
+  /* Move the input parameters hash of message z to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_HASH_E], in->hash, curve->primeOrderSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_HASH_E + orderWords);
+}
+
+/**
+  * @brief  Set the curve parameters of the ECDSA verification.
+  * @param  curve Curve context
+  */
+void PKA_ECDSAVerifCurve_Set(const PKA_CurveTypeDef *curve)
+{
+  uint32_t modWords = (curve->modulusSize + 3UL) / 4UL;
+  uint32_t orderWords = (curve->primeOrderSize + 3UL) / 4UL;
+
+  /* Get the prime order n length */
+  PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_ORDER_NB_BITS] = curve->primeOrderNbBits;
+
+  /* Get the modulus p length */
+  PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_MOD_NB_BITS] = curve->modulusNbBits;
+
+  /* Get the coefficient a sign */
+  PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_A_COEFF_SIGN] = curve->coefSign;
+
+  /* Move the curve parameters to PKA RAM */
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_A_COEFF], curve->coef, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_A_COEFF + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_MOD_GF], curve->modulus, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_MOD_GF + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_INITIAL_POINT_X], curve->basePointX, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_INITIAL_POINT_X + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_INITIAL_POINT_Y], curve->basePointY, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_INITIAL_POINT_Y + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECDSA_VERIF_IN_ORDER_N], curve->primeOrder, orderWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECDSA_VERIF_IN_ORDER_N + orderWords);
+}
+
+/**
+  * @brief  Return the index of the next item of a batch with a valid key index.
+  * @param  in Input information
+  * @param  index Index of the first item to check
+  * @retval Index of the item, in->itemNumber if there is none
+  */
+uint32_t PKA_ECDSAVerifBatch_Next(PKA_ECDSAVerifBatchInTypeDef *in, uint32_t index)
+{
+  while ((index < in->itemNumber) && (in->items[index].keyIndex >= in->keyNumber))
+  {
+    index++;
+  }
+  return index;
+}
+
+/**
+  * @brief  Set input parameters. Only the operands are converted, the curve
+  *         parameters and the Montgomery parameter are copied from the context.
+  * @param  hpka PKA handle
+  * @param  in Input information
+  */
+void PKA_ECCMulCtx_Set(PKA_HandleTypeDef *hpka, PKA_ECCMulCtxInTypeDef *in)
+{
+  const PKA_CurveTypeDef *curve = in->curve;
+  uint32_t modWords = (curve->modulusSize + 3UL) / 4UL;
+
+  /* Get the scalar multiplier k length */
+  PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_EXP_NB_BITS] = PKA_GetOptBitSize_u8(in->scalarMulSize, *(in->scalarMul));
+
+  /* Get the modulus length */
+  PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_OP_NB_BITS] = curve->modulusNbBits;
+
+  /* Get the coefficient a sign */
+  PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_A_COEFF_SIGN] = curve->coefSign;
+
+  /* Move the curve parameters to PKA RAM */
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_A_COEFF], curve->coef, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECC_SCALAR_MUL_IN_A_COEFF + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_MOD_GF], curve->modulus, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECC_SCALAR_MUL_IN_MOD_GF + modWords);
+
+  PKA_Memcpy_u32_to_u32(&PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_MONTGOMERY_PARAM], curve->montgomeryParam, modWords);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECC_SCALAR_MUL_IN_MONTGOMERY_PARAM + modWords);
+
+  /* Move the input parameters scalar multiplier k to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_ECC_SCALAR_MUL_IN_K], in->scalarMul, in->scalarMulSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_ECC_SCALAR_MUL_IN_K + ((in->scalarMulSize + 3UL) / 4UL));
+
+  /* Move the input parameters Point P coordinates to PKA RAM */
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_POINT_CHECK_IN_INITIAL_POINT_X], in->pointX, curve->modulusSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_POINT_CHECK_IN_INITIAL_POINT_X + modWords);
+
+  PKA_Memcpy_u8_to_u32(&PKA_RAM->RAM[PKA_POINT_CHECK_IN_INITIAL_POINT_Y], in->pointY, curve->modulusSize);
+  __PKA_RAM_PARAM_END(PKA_RAM->RAM, PKA_POINT_CHECK_IN_INITIAL_POINT_Y + modWords);
+}
+
 /**
   * @}
   */
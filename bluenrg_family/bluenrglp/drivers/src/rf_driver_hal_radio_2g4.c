@@ -18,6 +18,7 @@
   */
 #include "rf_driver_hal_radio_2g4.h"
 #include "rf_driver_hal_vtimer.h"
+#include <osal.h>
 
 /* Access address used only to sense medium with HAL_RADIO_CarrierSense() */
 #define FAKE_NETWORK_ID 0xAAAAAAAA
@@ -27,6 +28,47 @@
 static ActionPacket aPacket[2]; 
 static uint32_t networkID = 0x88DF88DF;
 
+/* Minimum back-to-back time: RADIO_SetReservedArea() removes 70 us of radio setup time */
+#define BURST_MIN_BACK_TO_BACK_TIME (80U)
+
+static ActionPacket burstPacket[HAL_RADIO_BURST_RING_SIZE];
+
+static struct {
+  uint8_t** txBuffers;
+  uint16_t nextBuffer; /* Index of the next buffer to load in the ring */
+  uint8_t (*Callback)(ActionPacket*, ActionPacket*);
+  HAL_RADIO_BurstStatusType status;
+} burst;
+
+static ActionPacket streamPacket[2];
+static uint8_t streamBuffer[2][MAX_PACKET_LENGTH];
+
+static struct {
+  circular_fifo_spsc_t *fifo;
+  uint8_t receiveLength;
+  volatile uint8_t stopRequest;
+  HAL_RADIO_StreamStatusType status;
+} stream;
+
+/* Links indexed by state machine. The entry 0 is never used. */
+static HAL_RADIO_LinkType *linkTable[STATEMACHINE_COUNT];
+
+#if !defined(CONFIG_DEVICE_BLUENRG_LP)
+static ActionPacket sweepPacket[2];
+static uint8_t sweepBuffer[HEADER_LENGTH];
+
+static struct {
+  uint8_t* channels;
+  int8_t* rssi;
+  uint16_t total;      /* Number of RX windows of the sweep */
+  uint16_t index;      /* RX window in progress */
+  uint8_t samples;
+  int16_t sum;         /* Sum of the valid samples of the current channel */
+  uint8_t valid;       /* Number of valid samples of the current channel */
+  uint8_t (*Callback)(ActionPacket*, ActionPacket*);
+} sweep;
+#endif
+
 static uint8_t CondRoutineTrue(ActionPacket* p)
 {
   return TRUE;
@@ -47,6 +89,86 @@ static uint8_t CondRoutineRxTrue(ActionPacket* p)
   return FALSE; 
 }
 
+static uint8_t BurstDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  burst.status.PacketsSent++;
+  
+  /* The first packet is executed again by the next laps of the ring: the PLL
+     calibration stored by RADIO_SetReservedArea() is no more needed */
+  p->ActionTag &= ~PLL_TRIG;
+  p->trans_packet.BYTE4 &= ~TXRXPACK_BYTE4_CALREQ_Msk;
+  
+  if(burst.Callback != NULL_0) {
+    burst.Callback(p, next);
+  }
+  
+  if(next == NULL_0) {
+    burst.status.EndTime = (uint32_t)TIMER_GetCurrentSysTime();
+    burst.status.Active = FALSE;
+  }
+  else if(burst.nextBuffer < burst.status.PacketCount) {
+    /* The packet just transmitted is executed again HAL_RADIO_BURST_RING_SIZE
+       packets later: load the next buffer in it. */
+    p->data = burst.txBuffers[burst.nextBuffer];
+    p->trans_packet.DATAPTR = BLUE_DATA_PTR_CAST(p->data);
+    burst.nextBuffer++;
+    if(burst.nextBuffer == burst.status.PacketCount) {
+      /* Last packet of the burst */
+      p->next_true = NULL_0;
+      p->next_false = NULL_0;
+    }
+  }
+  return TRUE;
+}
+
+static uint8_t StreamCondRoutine(ActionPacket* p)
+{
+  /* Go on with the other buffer until the streaming is stopped */
+  return (stream.stopRequest == FALSE);
+}
+
+static uint8_t StreamDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  HAL_RADIO_StreamItemHeaderType header;
+  uint16_t length;
+  
+  /* The first window is armed again two windows later: no more PLL calibration */
+  p->ActionTag &= ~PLL_TRIG;
+  p->trans_packet.BYTE4 &= ~TXRXPACK_BYTE4_CALREQ_Msk;
+  
+  if((p->status & BLUE_INTERRUPT1REG_RCVOK) != 0) {
+    /* The other buffer is already in use by the radio: store this one in the FIFO
+       before it is armed again. */
+    length = p->data[1];
+    if(length > stream.receiveLength) {
+      length = stream.receiveLength;
+    }
+    length += HEADER_LENGTH;
+    
+    Osal_MemSet(&header, 0, sizeof(header));
+    header.timestamp_receive = p->timestamp_receive;
+    header.rssi = (int8_t)p->rssi;
+    
+    if(fifo_spsc_put_var_len_item(stream.fifo, sizeof(header), (uint8_t *)&header, length, p->data) == 0) {
+      stream.status.PacketsReceived++;
+    }
+    else {
+      stream.status.PacketsDropped++;
+    }
+  }
+  else if((p->status & BLUE_INTERRUPT1REG_RCVCRCERR) != 0) {
+    stream.status.CrcErrors++;
+  }
+  else if((p->status & BLUE_INTERRUPT1REG_RCVTIMEOUT) != 0) {
+    stream.status.Timeouts++;
+  }
+  
+  if(next == NULL_0) {
+    stream.status.Active = FALSE;
+  }
+  return TRUE;
+}
+
 
 /**
 * @brief  This routine sets the network ID field for packet transmission and filtering for the receiving.
@@ -193,6 +315,661 @@ uint8_t HAL_RADIO_SendPacketWithAck(uint8_t channel,
   return returnValue; 
 }
 
+/**
+* @brief  This routine sends a burst of packets on a specific channel, starting at a specific time.
+*         Only the first packet is scheduled with the wakeup timer: the following ones are
+*         chained back-to-back by the radio ISR, without a new wakeup and PLL calibration.
+*         The packets are executed from a ring of HAL_RADIO_BURST_RING_SIZE ActionPackets,
+*         so the number of packets is not limited by the ring size.
+* @param  channel: Frequency channel between 0 to 39.
+* @param  wakeup_time: Time of the first transmission in us. This is relative time regarding now.
+*         Minimum wakeup_time of 230 us. TBR
+* @param  back_to_back_time: Time between the end of a packet and the start of the next one in us.
+*         Minimum value is 80 us. The default back-to-back time is restored when the function returns.
+* @param  txBuffers: Array of pointers to the TX data buffers. Second byte of each buffer must be the length of the data.
+*         The array and the buffers must remain valid until the end of the burst.
+* @param  count: Number of packets to send.
+* @param  Callback: This function is being called as data routine after each packet (it can be NULL).
+*         First ActionPacket is current action packet and the second one is next action packet.
+*         The next action packet is NULL after the last packet of the burst.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : Radio is busy, transmission has not been triggered.
+*/
+uint8_t HAL_RADIO_SendPacketBurst(uint8_t channel,
+                                  uint32_t wakeup_time,
+                                  uint32_t back_to_back_time,
+                                  uint8_t** txBuffers,
+                                  uint16_t count,
+                                  uint8_t (*Callback)(ActionPacket*, ActionPacket*))
+{
+  uint8_t returnValue = SUCCESS_0;
+  uint32_t dummy,time;
+  uint16_t ringSize, i;
+  
+  time = (uint32_t)TIMER_GetCurrentSysTime() + TIMER_UsToSystime(wakeup_time);
+  
+  if((channel > 39) || (count == 0) || (txBuffers == NULL_0) || (back_to_back_time < BURST_MIN_BACK_TO_BACK_TIME)) {
+    returnValue = INVALID_PARAMETER_C0;
+  }
+  
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    returnValue = RADIO_BUSY_C4;
+  }
+  
+  if(returnValue == SUCCESS_0) {
+    uint8_t map[5]= {0xFF,0xFF,0xFF,0xFF,0xFF};
+    RADIO_SetChannelMap(0, &map[0]);
+    RADIO_SetChannel(0, channel, 0);
+    RADIO_SetTxAttributes(0, networkID, 0x555555);
+    
+    ringSize = (count < HAL_RADIO_BURST_RING_SIZE) ? count : HAL_RADIO_BURST_RING_SIZE;
+    
+    burst.txBuffers = txBuffers;
+    burst.nextBuffer = ringSize;
+    burst.Callback = Callback;
+    burst.status.PacketCount = count;
+    burst.status.PacketsSent = 0;
+    burst.status.StartTime = time;
+    burst.status.EndTime = time;
+    burst.status.Active = TRUE;
+    
+    for(i = 0; i < ringSize; i++) {
+      burstPacket[i].StateMachineNo = STATE_MACHINE_0;
+      /* Only the first packet needs the PLL calibration */
+      burstPacket[i].ActionTag = (i == 0) ? (TXRX | PLL_TRIG) : TXRX;
+      burstPacket[i].WakeupTime = time;
+      burstPacket[i].MaxReceiveLength = 0; /* does not affect for Tx */
+      burstPacket[i].data = txBuffers[i];
+      if(i == (count - 1)) {
+        burstPacket[i].next_true = NULL_0;
+      }
+      else {
+        burstPacket[i].next_true = &burstPacket[(i + 1) % ringSize];
+      }
+      burstPacket[i].next_false = burstPacket[i].next_true;
+      burstPacket[i].condRoutine = CondRoutineTrue;
+      burstPacket[i].dataRoutine = BurstDataRoutine;
+    }
+    
+    /* The back-to-back time is stored in each packet by RADIO_SetReservedArea() */
+    RADIO_SetBackToBackTime(back_to_back_time);
+    for(i = 0; i < ringSize; i++) {
+      RADIO_SetReservedArea(&burstPacket[i]);
+    }
+    RADIO_SetBackToBackTime(BACK_TO_BACK_TIME);
+    
+    returnValue = RADIO_MakeActionPacketPending(&burstPacket[0]);
+    if(returnValue != SUCCESS_0) {
+      burst.status.Active = FALSE;
+    }
+  }
+  
+  return returnValue; 
+}
+
+/**
+* @brief  This routine returns the progress of the last burst started with HAL_RADIO_SendPacketBurst().
+*         The achieved throughput is PacketsSent / (EndTime - StartTime), the times being in STU.
+* @param[out] status: burst status.
+* @retval None
+*/
+void HAL_RADIO_GetBurstStatus(HAL_RADIO_BurstStatusType *status)
+{
+  *status = burst.status;
+}
+
+/**
+* @brief  This routine starts a continuous reception on a specific channel.
+*         Two RX ActionPackets looping on each other are used, so that the radio receives
+*         in one buffer while the packet received in the other one is stored in the FIFO.
+*         An RX window is opened back-to-back after the previous one, without rearming
+*         the radio from the application, until HAL_RADIO_StopReceiveStream() is called.
+*         Each packet received without CRC error is stored in the FIFO as a variable length item
+*         made of an HAL_RADIO_StreamItemHeaderType followed by the packet (header, length and data field).
+*         The items can be read from thread context with fifo_spsc_get_var_len_item().
+* @param  channel: Frequency channel between 0 to 39.
+* @param  wakeup_time: Time of the first RX window in us. This is relative time regarding now.
+*         Minimum wakeup_time of 230 us. TBR
+* @param  receive_timeout: Time of each RX window used to wait for the packet on us.
+* @param  receive_length: number of bytes that the link layer accepts in reception.
+* @param  fifo: single-producer/single-consumer FIFO where the received packets are stored by the radio ISR.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : Radio is busy, receiving has not been triggered.
+*/
+uint8_t HAL_RADIO_StartReceiveStream(uint8_t channel,
+                                     uint32_t wakeup_time,
+                                     uint32_t receive_timeout,
+                                     uint8_t receive_length,
+                                     circular_fifo_spsc_t *fifo)
+{
+  uint8_t returnValue = SUCCESS_0;
+  uint32_t dummy,time;
+  uint8_t i;
+  
+  time = (uint32_t)TIMER_GetCurrentSysTime() + TIMER_UsToSystime(wakeup_time);
+  
+  if((channel > 39) || (fifo == NULL_0)) {
+    returnValue = INVALID_PARAMETER_C0;
+  }
+  
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    returnValue = RADIO_BUSY_C4;
+  }
+  
+  if(returnValue == SUCCESS_0) {
+    uint8_t map[5]= {0xFF,0xFF,0xFF,0xFF,0xFF};
+    RADIO_SetChannelMap(0, &map[0]);
+    RADIO_SetChannel(0, channel, 0);
+    RADIO_SetTxAttributes(0, networkID, 0x555555);
+    RADIO_SetGlobalReceiveTimeout(receive_timeout);
+    
+    stream.fifo = fifo;
+    stream.receiveLength = receive_length;
+    stream.stopRequest = FALSE;
+    Osal_MemSet(&stream.status, 0, sizeof(stream.status));
+    stream.status.Active = TRUE;
+    
+    for(i = 0; i < 2; i++) {
+      streamPacket[i].StateMachineNo = STATE_MACHINE_0;
+      /* Only the first window needs the PLL calibration */
+      streamPacket[i].ActionTag = (i == 0) ? PLL_TRIG : 0;
+      streamPacket[i].WakeupTime = time;
+      streamPacket[i].MaxReceiveLength = receive_length;
+      streamPacket[i].data = streamBuffer[i];
+      streamPacket[i].next_true = &streamPacket[i ^ 1];
+      streamPacket[i].next_false = NULL_0;
+      streamPacket[i].condRoutine = StreamCondRoutine;
+      streamPacket[i].dataRoutine = StreamDataRoutine;
+    }
+    
+    RADIO_SetReservedArea(&streamPacket[0]);
+    RADIO_SetReservedArea(&streamPacket[1]);
+    returnValue = RADIO_MakeActionPacketPending(&streamPacket[0]);
+    if(returnValue != SUCCESS_0) {
+      stream.status.Active = FALSE;
+    }
+  }
+  
+  return returnValue;
+}
+
+/**
+* @brief  This routine stops the reception started with HAL_RADIO_StartReceiveStream().
+*         The radio stops at the end of the current RX window: the packet received in
+*         this window is still stored in the FIFO.
+* @retval None
+*/
+void HAL_RADIO_StopReceiveStream(void)
+{
+  stream.stopRequest = TRUE;
+}
+
+/**
+* @brief  This routine returns the counters of the reception started with HAL_RADIO_StartReceiveStream().
+* @param[out] status: streaming status.
+* @retval None
+*/
+void HAL_RADIO_GetStreamStatus(HAL_RADIO_StreamStatusType *status)
+{
+  *status = stream.status;
+}
+
+/**
+* @brief  This routine opens a link on a dedicated state machine.
+*         The network ID, CRC init, channel and channel map of the link are kept by its state machine,
+*         so that several links can be active at the same time and be served in the same radio activity.
+* @param[out] link: link context. It must remain valid until HAL_RADIO_LinkClose() is called.
+* @param  channel: Frequency channel between 0 to 39.
+* @param  networkID: network ID of the link. See HAL_RADIO_SetNetworkID().
+* @param  crc_init: CRC initialization value of the link.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter or no state machine available.
+*/
+uint8_t HAL_RADIO_LinkOpen(HAL_RADIO_LinkType *link, uint8_t channel, uint32_t networkID, uint32_t crc_init)
+{
+  uint8_t sm;
+  
+  if(channel > 39) {
+    return INVALID_PARAMETER_C0;
+  }
+  
+  for(sm = STATE_MACHINE_1; sm < STATEMACHINE_COUNT; sm++) {
+    if(linkTable[sm] == NULL_0) {
+      break;
+    }
+  }
+  if(sm == STATEMACHINE_COUNT) {
+    return INVALID_PARAMETER_C0;
+  }
+  
+  linkTable[sm] = link;
+  link->StateMachineNo = sm;
+  link->NetworkID = networkID;
+  link->CrcInit = crc_init;
+  link->ActionCount = 0;
+  RADIO_RSSIFilterInit(&link->RssiFilter, HAL_RADIO_LINK_RSSI_ATTACK_COEFF, HAL_RADIO_LINK_RSSI_DECAY_COEFF);
+  RADIO_SetTxAttributes(sm, networkID, crc_init);
+  
+  return HAL_RADIO_LinkSetChannel(link, channel, NULL_0);
+}
+
+/**
+* @brief  This routine closes a link and releases its state machine.
+* @param  link: link context.
+* @retval None
+*/
+void HAL_RADIO_LinkClose(HAL_RADIO_LinkType *link)
+{
+  if(linkTable[link->StateMachineNo] == link) {
+    linkTable[link->StateMachineNo] = NULL_0;
+  }
+  link->ActionCount = 0;
+}
+
+/**
+* @brief  This routine changes the channel and the channel map of a link.
+* @param  link: link context.
+* @param  channel: Frequency channel between 0 to 39.
+* @param  chan_remap: 37-bit channel map, see RADIO_SetChannelMap(). If NULL, the channel remapping is disabled.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : Radio is busy, the link has not been modified.
+*/
+uint8_t HAL_RADIO_LinkSetChannel(HAL_RADIO_LinkType *link, uint8_t channel, uint8_t *chan_remap)
+{
+  uint32_t dummy;
+  uint8_t i;
+  
+  if(channel > 39) {
+    return INVALID_PARAMETER_C0;
+  }
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    return RADIO_BUSY_C4;
+  }
+  
+  for(i = 0; i < 5; i++) {
+    link->ChannelMap[i] = (chan_remap == NULL_0) ? 0xFF : chan_remap[i];
+  }
+  link->Channel = channel;
+  RADIO_SetChannelMap(link->StateMachineNo, &link->ChannelMap[0]);
+  RADIO_SetChannel(link->StateMachineNo, channel, 0);
+  
+  return SUCCESS_0;
+}
+
+static uint8_t LinkDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  HAL_RADIO_LinkType *link = linkTable[p->StateMachineNo];
+  
+  if(link == NULL_0) {
+    return TRUE;
+  }
+  if(((p->ActionTag & TXRX) == 0) && ((p->status & BLUE_INTERRUPT1REG_RCVOK) != 0)) {
+    RADIO_RSSIFilterUpdate(&link->RssiFilter, (int8_t)p->rssi);
+  }
+  return link->callback[p - link->actionPacket](p, next);
+}
+
+static uint8_t LinkQueueAction(HAL_RADIO_LinkType *link,
+                               uint8_t actionTag,
+                               uint8_t* buffer,
+                               uint8_t receive_length,
+                               uint8_t (*Callback)(ActionPacket*, ActionPacket*))
+{
+  uint32_t dummy;
+  ActionPacket *p;
+  
+  if((linkTable[link->StateMachineNo] != link) || (link->ActionCount == HAL_RADIO_LINK_QUEUE_SIZE)) {
+    return INVALID_PARAMETER_C0;
+  }
+  /* The action packets of the link may be in use by the radio */
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    return RADIO_BUSY_C4;
+  }
+  
+  p = &link->actionPacket[link->ActionCount];
+  p->StateMachineNo = link->StateMachineNo;
+  p->ActionTag = actionTag;
+  p->MaxReceiveLength = receive_length;
+  p->data = buffer;
+  p->condRoutine = CondRoutineTrue;
+  p->dataRoutine = LinkDataRoutine;
+  link->callback[link->ActionCount] = (Callback != NULL_0) ? Callback : dataRoutineNull;
+  link->ActionCount++;
+  
+  return SUCCESS_0;
+}
+
+/**
+* @brief  This routine queues a packet transmission on a link.
+*         The transmission is executed by the next call to HAL_RADIO_LinkSchedule().
+* @param  link: link context.
+* @param  txBuffer: Pointer to TX data buffer. Second byte of this buffer must be the length of the data.
+* @param  Callback: This function is being called as data routine (it can be NULL).
+*         First ActionPacket is current action packet and the second one is next action packet.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter or queue of the link full.
+*           - 0xC4 : Radio is busy, the action has not been queued.
+*/
+uint8_t HAL_RADIO_LinkQueueTx(HAL_RADIO_LinkType *link,
+                              uint8_t* txBuffer,
+                              uint8_t (*Callback)(ActionPacket*, ActionPacket*))
+{
+  return LinkQueueAction(link, TXRX, txBuffer, 0, Callback);
+}
+
+/**
+* @brief  This routine queues a packet reception on a link.
+*         The reception is executed by the next call to HAL_RADIO_LinkSchedule().
+* @param  link: link context.
+* @param  rxBuffer: Pointer to RX data buffer. Second byte of this buffer must be the length of the data.
+* @param  receive_length: number of bytes that the link layer accepts in reception.
+* @param  Callback: This function is being called as data routine (it can be NULL).
+*         First ActionPacket is current action packet and the second one is next action packet.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter or queue of the link full.
+*           - 0xC4 : Radio is busy, the action has not been queued.
+*/
+uint8_t HAL_RADIO_LinkQueueRx(HAL_RADIO_LinkType *link,
+                              uint8_t* rxBuffer,
+                              uint8_t receive_length,
+                              uint8_t (*Callback)(ActionPacket*, ActionPacket*))
+{
+  return LinkQueueAction(link, 0, rxBuffer, receive_length, Callback);
+}
+
+/**
+* @brief  This routine executes the actions queued on all the open links in a single radio activity.
+*         The links are interleaved: the first action of each link is executed, then the second one, and so on.
+*         Only the first action is scheduled with the wakeup timer, the following ones are executed
+*         back-to-back. The PLL is calibrated again only when the channel changes.
+*         The queues of the links are emptied.
+* @param  wakeup_time: Time of the first action in us. This is relative time regarding now.
+*         Minimum wakeup_time of 230 us. TBR
+* @param  receive_timeout: Time of RX window used to wait for the packet on us, for all the RX actions.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter, no action queued.
+*           - 0xC4 : Radio is busy, the actions have not been triggered.
+*/
+uint8_t HAL_RADIO_LinkSchedule(uint32_t wakeup_time, uint32_t receive_timeout)
+{
+  uint8_t returnValue = SUCCESS_0;
+  uint32_t dummy,time;
+  ActionPacket *first = NULL_0, *last = NULL_0, *p;
+  uint8_t sm, i, channel = 0;
+  
+  time = (uint32_t)TIMER_GetCurrentSysTime() + TIMER_UsToSystime(wakeup_time);
+  
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    return RADIO_BUSY_C4;
+  }
+  
+  for(i = 0; i < HAL_RADIO_LINK_QUEUE_SIZE; i++) {
+    for(sm = STATE_MACHINE_1; sm < STATEMACHINE_COUNT; sm++) {
+      if((linkTable[sm] == NULL_0) || (i >= linkTable[sm]->ActionCount)) {
+        continue;
+      }
+      p = &linkTable[sm]->actionPacket[i];
+      p->WakeupTime = time;
+      p->next_true = NULL_0;
+      p->next_false = NULL_0;
+      if((first == NULL_0) || (linkTable[sm]->Channel != channel)) {
+        p->ActionTag |= PLL_TRIG;
+      }
+      else {
+        p->ActionTag &= ~PLL_TRIG;
+      }
+      channel = linkTable[sm]->Channel;
+      if(first == NULL_0) {
+        first = p;
+      }
+      else {
+        last->next_true = p;
+        last->next_false = p;
+      }
+      last = p;
+    }
+  }
+  
+  if(first == NULL_0) {
+    return INVALID_PARAMETER_C0;
+  }
+  
+  RADIO_SetGlobalReceiveTimeout(receive_timeout);
+  
+  /* The type of the next action is stored by RADIO_SetReservedArea(): link all the packets first */
+  for(p = first; p != NULL_0; p = p->next_true) {
+    RADIO_SetReservedArea(p);
+  }
+  for(sm = STATE_MACHINE_1; sm < STATEMACHINE_COUNT; sm++) {
+    if(linkTable[sm] != NULL_0) {
+      linkTable[sm]->ActionCount = 0;
+    }
+  }
+  
+  returnValue = RADIO_MakeActionPacketPending(first);
+  
+  return returnValue;
+}
+
+/**
+* @brief  This routine changes the coefficients of the RSSI filter of a link and restarts the filter.
+*         The RSSI of each packet received without error on the link is added to the filter.
+* @param  link: link context.
+* @param  attack_coeff: the weight of a packet stronger than the average is 2^-attack_coeff, from 0 to 4.
+* @param  decay_coeff: the weight of a packet weaker than the average is 2^-decay_coeff, from 0 to 4.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*/
+uint8_t HAL_RADIO_LinkSetRssiFilter(HAL_RADIO_LinkType *link, uint8_t attack_coeff, uint8_t decay_coeff)
+{
+  if((attack_coeff > RSSI_FILTER_MAX_COEFF) || (decay_coeff > RSSI_FILTER_MAX_COEFF)) {
+    return INVALID_PARAMETER_C0;
+  }
+  RADIO_RSSIFilterInit(&link->RssiFilter, attack_coeff, decay_coeff);
+  
+  return SUCCESS_0;
+}
+
+/**
+* @brief  This routine returns the average RSSI of the packets received on a link.
+* @param  link: link context.
+* @retval int8_t: average RSSI in dBm, 127 if no packet has been received.
+*/
+int8_t HAL_RADIO_LinkGetRssi(HAL_RADIO_LinkType *link)
+{
+  return RADIO_RSSIFilterGet(&link->RssiFilter);
+}
+
+#ifdef CONFIG_DEVICE_BLUENRG_LP
+/* On BlueNRG-LP the RSSI read at the end of an RX window is not valid: HAL_RADIO_CarrierSense()
+   freezes the demodulator while the radio is still in RX, which cannot be done between two
+   chained windows. Each sample is then taken by HAL_RADIO_CarrierSense(), one after the other. */
+static uint8_t SweepCarrierSense(uint8_t* channels, uint8_t count, uint8_t samples, int8_t* rssi)
+{
+  uint8_t returnValue = SUCCESS_0;
+  uint32_t dummy;
+  uint16_t loop;
+  int16_t sum;
+  int8_t sample;
+  uint8_t i, j, valid;
+  
+  for(i = 0; i < count; i++) {
+    rssi[i] = 127;
+  }
+  
+  for(i = 0; (i < count) && (returnValue == SUCCESS_0); i++) {
+    sum = 0;
+    valid = 0;
+    for(j = 0; (j < samples) && (returnValue == SUCCESS_0); j++) {
+      returnValue = HAL_RADIO_CarrierSense(channels[i], &sample);
+      if((returnValue == SUCCESS_0) && (sample != 127)) {
+        sum += (int16_t)sample;
+        valid++;
+      }
+      /* The RX window is skipped by HAL_RADIO_CarrierSense(): wait for the radio ISR
+         to close it before the next capture. loop variable just to protect from infinite loop */
+      loop = 0;
+      while((RADIO_GetStatus(&dummy) != BLUE_IDLE_0) && (loop++ < 60000));
+    }
+    if((returnValue == SUCCESS_0) && (valid != 0)) {
+      rssi[i] = (int8_t)(sum / valid);
+    }
+  }
+  
+  return returnValue;
+}
+
+#else
+
+static uint8_t SweepCondRoutine(ActionPacket* p)
+{
+  uint16_t next = sweep.index + 1;
+  
+  if(next >= sweep.total) {
+    return FALSE;
+  }
+  /* The next RX window has not started yet: move it to its channel */
+  RADIO_SetChannel(0, sweep.channels[next / sweep.samples], 0);
+  return TRUE;
+}
+
+static uint8_t SweepDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  /* The RSSI is read by the radio ISR at the end of the RX window, even on timeout */
+  if(p->rssi != 127) {
+    sweep.sum += (int16_t)p->rssi;
+    sweep.valid++;
+  }
+  
+  if((sweep.index % sweep.samples) == (sweep.samples - 1)) {
+    /* Last sample of the channel */
+    sweep.rssi[sweep.index / sweep.samples] = (sweep.valid != 0) ? (int8_t)(sweep.sum / sweep.valid) : 127;
+    sweep.sum = 0;
+    sweep.valid = 0;
+  }
+  sweep.index++;
+  
+  if((next == NULL_0) && (sweep.Callback != NULL_0)) {
+    sweep.Callback(p, next);
+  }
+  return TRUE;
+}
+
+#endif /* CONFIG_DEVICE_BLUENRG_LP */
+
+/**
+* @brief  This routine measures the energy on a list of channels in a single radio activity.
+*         The RX windows are chained back-to-back, the channel being changed between two windows
+*         by the radio ISR, and the RSSI read at the end of each window is stored.
+*         No packet is expected: a network ID that does not match any device is used.
+* @note   On BlueNRG-LP the RSSI of a timed out RX window is not valid. Each sample is a
+*         HAL_RADIO_CarrierSense() capture instead: the function is blocking and returns
+*         when the rssi array is complete, wakeup_time and rx_window are not used and
+*         Callback is called before returning, with the ActionPacket of the last capture.
+* @param  channels: list of channels to measure, between 0 to 39.
+*         The array must remain valid until the end of the sweep.
+* @param  count: number of channels in the list, from 1 to 40.
+* @param  samples: number of RX windows on each channel, from 1 to 255.
+*         The RSSI of a channel is the average of its samples, in dBm.
+* @param  wakeup_time: Time of the first RX window in us. This is relative time regarding now.
+*         Minimum wakeup_time of 230 us. TBR
+* @param  rx_window: duration of each RX window in us.
+* @param[out] rssi: array of count elements where the RSSI of each channel is stored.
+*         127 if no valid sample has been measured on the channel.
+* @param  Callback: This function is being called as data routine at the end of the sweep (it can be NULL).
+*         The second ActionPacket is NULL. The rssi array is complete when it is called.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : Radio is busy, the sweep has not been triggered.
+*             On BlueNRG-LP, the radio became busy during the sweep: the channels not
+*             measured are set to 127.
+*/
+uint8_t HAL_RADIO_EnergySweep(uint8_t* channels,
+                              uint8_t count,
+                              uint8_t samples,
+                              uint32_t wakeup_time,
+                              uint32_t rx_window,
+                              int8_t* rssi,
+                              uint8_t (*Callback)(ActionPacket*, ActionPacket*))
+{
+  uint8_t returnValue = SUCCESS_0;
+  uint32_t dummy;
+  uint8_t i;
+  
+  if((channels == NULL_0) || (rssi == NULL_0) || (count == 0) || (count > 40) || (samples == 0)) {
+    returnValue = INVALID_PARAMETER_C0;
+  }
+  else {
+    for(i = 0; i < count; i++) {
+      if(channels[i] > 39) {
+        returnValue = INVALID_PARAMETER_C0;
+      }
+    }
+  }
+  
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    returnValue = RADIO_BUSY_C4;
+  }
+  
+#ifdef CONFIG_DEVICE_BLUENRG_LP
+  if(returnValue == SUCCESS_0) {
+    returnValue = SweepCarrierSense(channels, count, samples, rssi);
+    if((returnValue == SUCCESS_0) && (Callback != NULL_0)) {
+      Callback(&aPacket[0], NULL_0);
+    }
+  }
+#else
+  if(returnValue == SUCCESS_0) {
+    uint32_t time = (uint32_t)TIMER_GetCurrentSysTime() + TIMER_UsToSystime(wakeup_time);
+    uint8_t map[5]= {0xFF,0xFF,0xFF,0xFF,0xFF};
+    RADIO_SetChannelMap(0, &map[0]);
+    RADIO_SetChannel(0, channels[0], 0);
+    RADIO_SetTxAttributes(0, FAKE_NETWORK_ID, 0x555555);
+    RADIO_SetGlobalReceiveTimeout(rx_window);
+    
+    sweep.channels = channels;
+    sweep.rssi = rssi;
+    sweep.total = (uint16_t)count * samples;
+    sweep.index = 0;
+    sweep.samples = samples;
+    sweep.sum = 0;
+    sweep.valid = 0;
+    sweep.Callback = Callback;
+    
+    for(i = 0; i < 2; i++) {
+      sweepPacket[i].StateMachineNo = STATE_MACHINE_0;
+      /* The PLL is calibrated before each window, since the channel may change */
+      sweepPacket[i].ActionTag = PLL_TRIG;
+      sweepPacket[i].WakeupTime = time;
+      sweepPacket[i].MaxReceiveLength = 0;
+      sweepPacket[i].data = sweepBuffer;
+      sweepPacket[i].next_true = &sweepPacket[i ^ 1];
+      sweepPacket[i].next_false = NULL_0;
+      sweepPacket[i].condRoutine = SweepCondRoutine;
+      sweepPacket[i].dataRoutine = SweepDataRoutine;
+    }
+    
+    RADIO_SetReservedArea(&sweepPacket[0]);
+    RADIO_SetReservedArea(&sweepPacket[1]);
+    returnValue = RADIO_MakeActionPacketPending(&sweepPacket[0]);
+  }
+#endif
+  
+  return returnValue;
+}
+
 #ifdef CONFIG_DEVICE_BLUENRG_LP
 
 static uint8_t CarrierSenseCallback(ActionPacket* p, ActionPacket* next)
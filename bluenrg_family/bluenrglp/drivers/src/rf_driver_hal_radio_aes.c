@@ -0,0 +1,659 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_radio_aes.c
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP HAL AES CTR and CCM modes on the manual AES unit of the radio
+  * @details The key registers are written once per operation. An operation is a
+  * sequence of block encryptions of two kinds: counter blocks (CTR) and CBC-MAC
+  * blocks (CCM only). The input of the next block is packed while the unit encrypts
+  * the current one, and the result of the current block is processed after the next
+  * block has been started. In CCM the two kinds of blocks are interleaved, so that
+  * the input of a CBC-MAC block is ready when the previous CBC-MAC block completes.
+  * The blocks are completed either by polling or by the BLE TX RX interrupt.
+  * All the buffers are in the AES byte order (most significant byte first), unlike
+  * RADIO_EncryptPlainData() which takes the key and the blocks reversed.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#include "rf_driver_hal_radio_aes.h"
+#include "rf_driver_hal_def.h"
+#include <osal.h>
+
+#define AES_KIND_NONE         (0U)
+#define AES_KIND_CTR          (1U)
+#define AES_KIND_MAC          (2U)
+
+#define AES_MODE_CTR          (0U)
+#define AES_MODE_CCM_ENCRYPT  (1U)
+#define AES_MODE_CCM_DECRYPT  (2U)
+
+/* Polls of MANAESSTATREG before giving up a block, as RADIO_EncryptPlainData() */
+#define AES_POLL_MAX          (100U)
+
+#define AES_GET32(p)          (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                               ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+#define AES_PUT32(p, v)       do { (p)[0] = (uint8_t)((v) >> 24); (p)[1] = (uint8_t)((v) >> 16); \
+                                   (p)[2] = (uint8_t)((v) >> 8); (p)[3] = (uint8_t)(v); } while(0)
+
+#define AES_BYTE(w, i)        ((uint8_t)((w)[(i) >> 2] >> (24U - 8U * ((i) & 3U))))
+
+/* Only one operation can use the AES unit at a time */
+static HAL_RADIO_AesType *aesActive;
+
+#if HAL_RADIO_AES_SOFTWARE_ENABLE
+
+static const uint8_t aesSbox[256] = {
+  0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+  0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+  0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+  0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+  0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+  0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+  0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+  0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+  0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+  0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+  0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+  0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+  0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+  0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+  0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+  0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static uint32_t aesSoftwareResult[4];
+
+static uint8_t AesXtime(uint8_t x)
+{
+  return (uint8_t)((x << 1) ^ (((x & 0x80U) != 0U) ? 0x1BU : 0x00U));
+}
+
+static uint32_t AesSubWord(uint32_t w)
+{
+  return ((uint32_t)aesSbox[w >> 24] << 24) | ((uint32_t)aesSbox[(w >> 16) & 0xFFU] << 16) |
+         ((uint32_t)aesSbox[(w >> 8) & 0xFFU] << 8) | (uint32_t)aesSbox[w & 0xFFU];
+}
+
+static void AesSoftwareExpandKey(HAL_RADIO_AesType *aes)
+{
+  uint32_t *rk = aes->roundKey;
+  uint32_t t;
+  uint8_t i, rcon = 0x01U;
+
+  for(i = 0; i < 4; i++) {
+    rk[i] = aes->key[i];
+  }
+  for(i = 4; i < 44; i++) {
+    t = rk[i - 1];
+    if((i & 3U) == 0U) {
+      t = AesSubWord((t << 8) | (t >> 24)) ^ ((uint32_t)rcon << 24);
+      rcon = AesXtime(rcon);
+    }
+    rk[i] = rk[i - 4] ^ t;
+  }
+}
+
+/* FIPS-197 cipher, the state is stored column by column */
+static void AesSoftwareEncrypt(const uint32_t *rk, const uint32_t *in, uint32_t *out)
+{
+  uint8_t s[16], t[16];
+  uint8_t round, c, a0, a1, a2, a3, x;
+
+  for(c = 0; c < 4; c++) {
+    AES_PUT32(&s[4 * c], in[c] ^ rk[c]);
+  }
+  for(round = 1; round <= 10; round++) {
+    /* SubBytes and ShiftRows */
+    for(c = 0; c < 4; c++) {
+      t[4 * c]     = aesSbox[s[4 * c]];
+      t[4 * c + 1] = aesSbox[s[4 * ((c + 1) & 3) + 1]];
+      t[4 * c + 2] = aesSbox[s[4 * ((c + 2) & 3) + 2]];
+      t[4 * c + 3] = aesSbox[s[4 * ((c + 3) & 3) + 3]];
+    }
+    /* MixColumns, except in the last round */
+    for(c = 0; c < 4; c++) {
+      a0 = t[4 * c];
+      a1 = t[4 * c + 1];
+      a2 = t[4 * c + 2];
+      a3 = t[4 * c + 3];
+      if(round != 10) {
+        x = a0 ^ a1 ^ a2 ^ a3;
+        t[4 * c]     = a0 ^ x ^ AesXtime(a0 ^ a1);
+        t[4 * c + 1] = a1 ^ x ^ AesXtime(a1 ^ a2);
+        t[4 * c + 2] = a2 ^ x ^ AesXtime(a2 ^ a3);
+        t[4 * c + 3] = a3 ^ x ^ AesXtime(a3 ^ a0);
+      }
+      AES_PUT32(&s[4 * c], AES_GET32(&t[4 * c]) ^ rk[4 * round + c]);
+    }
+  }
+  for(c = 0; c < 4; c++) {
+    out[c] = AES_GET32(&s[4 * c]);
+  }
+}
+
+#endif /* HAL_RADIO_AES_SOFTWARE_ENABLE */
+
+static void AesLoadKey(HAL_RADIO_AesType *aes)
+{
+#if !HAL_RADIO_AES_SOFTWARE_ENABLE
+  BLUE->MANAESKEY0REG = aes->key[0];
+  BLUE->MANAESKEY1REG = aes->key[1];
+  BLUE->MANAESKEY2REG = aes->key[2];
+  BLUE->MANAESKEY3REG = aes->key[3];
+#endif
+}
+
+static void AesBlockStart(HAL_RADIO_AesType *aes, const uint32_t *in)
+{
+#if HAL_RADIO_AES_SOFTWARE_ENABLE
+  AesSoftwareEncrypt(aes->roundKey, in, aesSoftwareResult);
+#else
+  BLUE->MANAESCLEARTEXT0REG = in[0];
+  BLUE->MANAESCLEARTEXT1REG = in[1];
+  BLUE->MANAESCLEARTEXT2REG = in[2];
+  BLUE->MANAESCLEARTEXT3REG = in[3];
+  if(aes->Callback != NULL_0) {
+    BLUE->MANAESCMDREG = BLUE_MANAESCMDREG_START | BLUE_MANAESCMDREG_INTENA;
+  }
+  else {
+    BLUE->MANAESCMDREG = BLUE_MANAESCMDREG_START;
+  }
+#endif
+}
+
+static void AesBlockWait(void)
+{
+#if !HAL_RADIO_AES_SOFTWARE_ENABLE
+  volatile uint32_t ii = 0;
+
+  while((BLUE->MANAESSTATREG == 0U) && (ii < AES_POLL_MAX)) {
+    ii++;
+  }
+#endif
+}
+
+static void AesBlockRead(uint32_t *out)
+{
+#if HAL_RADIO_AES_SOFTWARE_ENABLE
+  out[0] = aesSoftwareResult[0];
+  out[1] = aesSoftwareResult[1];
+  out[2] = aesSoftwareResult[2];
+  out[3] = aesSoftwareResult[3];
+#else
+  out[0] = BLUE->MANAESCIPHERTEXT0REG;
+  out[1] = BLUE->MANAESCIPHERTEXT1REG;
+  out[2] = BLUE->MANAESCIPHERTEXT2REG;
+  out[3] = BLUE->MANAESCIPHERTEXT3REG;
+#endif
+}
+
+/* Pack a block of data, zero padded if shorter than 16 bytes */
+static void AesPackBlock(uint32_t *w, const uint8_t *p, uint16_t n)
+{
+  uint8_t pad[HAL_RADIO_AES_BLOCK_SIZE];
+
+  if(n < HAL_RADIO_AES_BLOCK_SIZE) {
+    Osal_MemSet(pad, 0, sizeof(pad));
+    Osal_MemCpy(pad, p, n);
+    p = pad;
+  }
+  w[0] = AES_GET32(p);
+  w[1] = AES_GET32(p + 4);
+  w[2] = AES_GET32(p + 8);
+  w[3] = AES_GET32(p + 12);
+}
+
+static uint16_t AesPayloadLength(HAL_RADIO_AesType *aes, uint16_t block)
+{
+  uint16_t left = aes->length - block * HAL_RADIO_AES_BLOCK_SIZE;
+
+  return (left < HAL_RADIO_AES_BLOCK_SIZE) ? left : HAL_RADIO_AES_BLOCK_SIZE;
+}
+
+/* Block m of the CBC-MAC input: the additional data, preceded by its length, then the payload.
+   The block 0 (B0) is the initial value of aes->mac. */
+static void AesMacBlock(HAL_RADIO_AesType *aes, uint16_t m, uint32_t *w)
+{
+  uint8_t b[HAL_RADIO_AES_BLOCK_SIZE];
+  uint16_t pos, block;
+  uint8_t k;
+
+  if(m <= aes->aadBlocks) {
+    pos = (m - 1U) * HAL_RADIO_AES_BLOCK_SIZE;
+    for(k = 0; k < HAL_RADIO_AES_BLOCK_SIZE; k++, pos++) {
+      if(pos < 2U) {
+        b[k] = (uint8_t)(aes->aadLength >> (8U - 8U * pos));
+      }
+      else if(pos - 2U < aes->aadLength) {
+        b[k] = aes->aad[pos - 2U];
+      }
+      else {
+        b[k] = 0;
+      }
+    }
+    AesPackBlock(w, b, HAL_RADIO_AES_BLOCK_SIZE);
+  }
+  else {
+    block = m - 1U - aes->aadBlocks;
+    /* The CBC-MAC is computed on the plaintext: the output buffer when decrypting */
+    AesPackBlock(w, ((aes->mode == AES_MODE_CCM_DECRYPT) ? aes->out : aes->in) + block * HAL_RADIO_AES_BLOCK_SIZE,
+                 AesPayloadLength(aes, block));
+  }
+}
+
+/* Pack the input of the next block. A CBC-MAC block is preferred, when it does not depend on a
+   block still in progress, otherwise a counter block is used. */
+static void AesPrepare(HAL_RADIO_AesType *aes)
+{
+  uint32_t w[4];
+  uint16_t m = aes->macNext;
+  uint8_t ready, i;
+
+  if(aes->nextKind != AES_KIND_NONE) {
+    return;
+  }
+
+  ready = (m < aes->macCount) && (m == aes->macDone);
+  if(ready && (aes->mode == AES_MODE_CCM_DECRYPT) && (m > aes->aadBlocks)) {
+    /* Payload block m - 1 - aadBlocks is decrypted by the counter block m - aadBlocks */
+    ready = (aes->ctrDone > (uint16_t)(m - aes->aadBlocks));
+  }
+
+  if(ready) {
+    if(m == 0U) {
+      for(i = 0; i < 4; i++) {
+        aes->next[i] = aes->mac[i];
+      }
+    }
+    else {
+      AesMacBlock(aes, m, w);
+      for(i = 0; i < 4; i++) {
+        aes->next[i] = aes->mac[i] ^ w[i];
+      }
+    }
+    aes->macNext++;
+    aes->nextKind = AES_KIND_MAC;
+  }
+  else if((aes->ctrNext < aes->ctrCount) &&
+          ((aes->mode != AES_MODE_CCM_ENCRYPT) || (aes->ctrNext == 0U) || (aes->ctrNext + aes->aadBlocks < aes->macNext))) {
+    /* When encrypting, the plaintext of a payload block is packed for the CBC-MAC before
+       its counter block overwrites it (the output can be the input buffer) */
+    for(i = 0; i < 4; i++) {
+      aes->next[i] = aes->counter[i];
+    }
+    /* 128-bit increment */
+    for(i = 4; i > 0; i--) {
+      if(++aes->counter[i - 1U] != 0U) {
+        break;
+      }
+    }
+    aes->ctrNext++;
+    aes->nextKind = AES_KIND_CTR;
+  }
+}
+
+static uint8_t AesStartNext(HAL_RADIO_AesType *aes)
+{
+  if(aes->nextKind == AES_KIND_NONE) {
+    return FALSE;
+  }
+  aes->currentKind = aes->nextKind;
+  aes->nextKind = AES_KIND_NONE;
+  AesBlockStart(aes, aes->next);
+  return TRUE;
+}
+
+static void AesProcess(HAL_RADIO_AesType *aes, uint8_t kind, const uint32_t *r)
+{
+  const uint8_t *in;
+  uint8_t *out;
+  uint16_t block, n;
+  uint8_t i;
+
+  if(kind == AES_KIND_MAC) {
+    for(i = 0; i < 4; i++) {
+      aes->mac[i] = r[i];
+    }
+    aes->macDone++;
+    return;
+  }
+
+  block = aes->ctrDone++;
+  if(aes->mode != AES_MODE_CTR) {
+    /* The counter block 0 masks the tag */
+    if(block == 0U) {
+      for(i = 0; i < 4; i++) {
+        aes->s0[i] = r[i];
+      }
+      return;
+    }
+    block--;
+  }
+
+  n = AesPayloadLength(aes, block);
+  in = aes->in + block * HAL_RADIO_AES_BLOCK_SIZE;
+  out = aes->out + block * HAL_RADIO_AES_BLOCK_SIZE;
+  if(n == HAL_RADIO_AES_BLOCK_SIZE) {
+    for(i = 0; i < 4; i++) {
+      AES_PUT32(out + 4 * i, AES_GET32(in + 4 * i) ^ r[i]);
+    }
+  }
+  else {
+    for(i = 0; i < n; i++) {
+      out[i] = in[i] ^ AES_BYTE(r, i);
+    }
+  }
+}
+
+static void AesFinish(HAL_RADIO_AesType *aes)
+{
+  uint8_t status = SUCCESS_0;
+  uint8_t diff = 0;
+  uint8_t i;
+
+  if(aes->mode == AES_MODE_CCM_ENCRYPT) {
+    for(i = 0; i < aes->tagLength; i++) {
+      aes->tag[i] = AES_BYTE(aes->mac, i) ^ AES_BYTE(aes->s0, i);
+    }
+  }
+  else if(aes->mode == AES_MODE_CCM_DECRYPT) {
+    for(i = 0; i < aes->tagLength; i++) {
+      diff |= aes->tag[i] ^ AES_BYTE(aes->mac, i) ^ AES_BYTE(aes->s0, i);
+    }
+    if(diff != 0U) {
+      /* The plaintext must not be used */
+      Osal_MemSet(aes->out, 0, aes->length);
+      status = HAL_RADIO_AES_MIC_FAILURE_3D;
+    }
+  }
+
+  aesActive = NULL_0;
+  aes->status = status;
+  aes->busy = FALSE;
+  if(aes->Callback != NULL_0) {
+    aes->Callback(aes, status);
+  }
+}
+
+/* A block is complete: start the next one, which was packed in advance, then process the result */
+static void AesStep(HAL_RADIO_AesType *aes)
+{
+  uint32_t r[4];
+  uint8_t kind = aes->currentKind;
+  uint8_t started;
+
+  AesBlockRead(r);
+  started = AesStartNext(aes);
+  AesProcess(aes, kind, r);
+  AesPrepare(aes);
+  if(started == FALSE) {
+    /* The next block needed the result of this one */
+    if(AesStartNext(aes) == FALSE) {
+      AesFinish(aes);
+      return;
+    }
+    AesPrepare(aes);
+  }
+}
+
+/* Reserve the AES unit for aes. The check and the reservation are atomic, so that a call from
+   an interrupt in between cannot start a second operation. The interrupt handler does not
+   use aesActive before AesRun() starts the first block. */
+static uint8_t AesClaim(HAL_RADIO_AesType *aes)
+{
+  uint8_t claimed = FALSE;
+
+  ATOMIC_SECTION_BEGIN();
+  if((aesActive == NULL_0) && (aes->busy == FALSE)) {
+    aes->busy = TRUE;
+    aesActive = aes;
+    claimed = TRUE;
+  }
+  ATOMIC_SECTION_END();
+
+  return claimed;
+}
+
+/* Run an operation whose parameters are set. Blocking if there is no callback. */
+static uint8_t AesRun(HAL_RADIO_AesType *aes)
+{
+  aes->ctrNext = 0;
+  aes->ctrDone = 0;
+  aes->macNext = 0;
+  aes->macDone = 0;
+  aes->nextKind = AES_KIND_NONE;
+  aes->status = SUCCESS_0;
+
+  AesLoadKey(aes);
+  AesPrepare(aes);
+  if(AesStartNext(aes) == FALSE) {
+    /* Empty payload */
+    AesFinish(aes);
+    return aes->status;
+  }
+  AesPrepare(aes);
+
+  if((aes->Callback == NULL_0) || HAL_RADIO_AES_SOFTWARE_ENABLE) {
+    while(aes->busy) {
+      AesBlockWait();
+      AesStep(aes);
+    }
+    return aes->status;
+  }
+  return SUCCESS_0;
+}
+
+/**
+* @brief  This routine initializes the context of an AES-128 key.
+* @param[out] aes: AES context.
+* @param  key: 16-byte key.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC4 : An operation is running on the context.
+*/
+uint8_t HAL_RADIO_AesInit(HAL_RADIO_AesType *aes, const uint8_t *key)
+{
+  if(aes->busy) {
+    return RADIO_BUSY_C4;
+  }
+  Osal_MemSet(aes, 0, sizeof(HAL_RADIO_AesType));
+  aes->key[0] = AES_GET32(key);
+  aes->key[1] = AES_GET32(key + 4);
+  aes->key[2] = AES_GET32(key + 8);
+  aes->key[3] = AES_GET32(key + 12);
+#if HAL_RADIO_AES_SOFTWARE_ENABLE
+  AesSoftwareExpandKey(aes);
+#endif
+
+  return SUCCESS_0;
+}
+
+static uint8_t AesCcmStart(HAL_RADIO_AesType *aes, uint8_t mode,
+                           const uint8_t *nonce, uint8_t nonce_length,
+                           const uint8_t *aad, uint16_t aad_length,
+                           const uint8_t *in, uint8_t *out, uint16_t length,
+                           uint8_t *tag, uint8_t tag_length,
+                           void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status))
+{
+  uint8_t b[HAL_RADIO_AES_BLOCK_SIZE];
+  uint8_t q = 15U - nonce_length;
+  uint16_t payloadBlocks;
+
+  if((nonce_length < 7U) || (nonce_length > 13U) || (tag_length < 4U) || (tag_length > 16U) ||
+     ((tag_length & 1U) != 0U) || (aad_length >= 0xFF00U)) {
+    return INVALID_PARAMETER_C0;
+  }
+  if(AesClaim(aes) == FALSE) {
+    return RADIO_BUSY_C4;
+  }
+
+  /* B0: flags, nonce and payload length, initial value of the CBC-MAC */
+  Osal_MemSet(b, 0, sizeof(b));
+  b[0] = (uint8_t)(((aad_length != 0U) ? 0x40U : 0x00U) | (((tag_length - 2U) / 2U) << 3) | (q - 1U));
+  Osal_MemCpy(&b[1], nonce, nonce_length);
+  b[14] = (uint8_t)(length >> 8);
+  b[15] = (uint8_t)length;
+  AesPackBlock(aes->mac, b, HAL_RADIO_AES_BLOCK_SIZE);
+
+  /* A0: flags, nonce and counter 0 */
+  Osal_MemSet(b, 0, sizeof(b));
+  b[0] = q - 1U;
+  Osal_MemCpy(&b[1], nonce, nonce_length);
+  AesPackBlock(aes->counter, b, HAL_RADIO_AES_BLOCK_SIZE);
+
+  payloadBlocks = (length + HAL_RADIO_AES_BLOCK_SIZE - 1U) / HAL_RADIO_AES_BLOCK_SIZE;
+  aes->aadBlocks = (aad_length != 0U) ? (aad_length + 2U + HAL_RADIO_AES_BLOCK_SIZE - 1U) / HAL_RADIO_AES_BLOCK_SIZE : 0U;
+  aes->macCount = 1U + aes->aadBlocks + payloadBlocks;
+  aes->ctrCount = 1U + payloadBlocks;
+  aes->mode = mode;
+  aes->aad = aad;
+  aes->aadLength = aad_length;
+  aes->in = in;
+  aes->out = out;
+  aes->length = length;
+  aes->tag = tag;
+  aes->tagLength = tag_length;
+  aes->Callback = Callback;
+
+  return AesRun(aes);
+}
+
+/**
+* @brief  This routine encrypts or decrypts data in counter (CTR) mode.
+* @param  aes: AES context.
+* @param  counter: 16-byte initial counter block. It is incremented as a 128-bit big endian integer.
+* @param  in: input data.
+* @param[out] out: output data. It can be the input buffer.
+* @param  length: number of bytes.
+* @param  Callback: function called when the operation is complete, from the BLE TX RX interrupt.
+*         If NULL, the routine returns when the operation is complete.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC4 : The AES unit is in use.
+*/
+uint8_t HAL_RADIO_AesCtr(HAL_RADIO_AesType *aes,
+                         const uint8_t *counter,
+                         const uint8_t *in,
+                         uint8_t *out,
+                         uint16_t length,
+                         void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status))
+{
+  if(AesClaim(aes) == FALSE) {
+    return RADIO_BUSY_C4;
+  }
+
+  AesPackBlock(aes->counter, counter, HAL_RADIO_AES_BLOCK_SIZE);
+  aes->aadBlocks = 0;
+  aes->macCount = 0;
+  aes->ctrCount = (length + HAL_RADIO_AES_BLOCK_SIZE - 1U) / HAL_RADIO_AES_BLOCK_SIZE;
+  aes->mode = AES_MODE_CTR;
+  aes->in = in;
+  aes->out = out;
+  aes->length = length;
+  aes->Callback = Callback;
+
+  return AesRun(aes);
+}
+
+/**
+* @brief  This routine encrypts and authenticates data in CCM mode (NIST SP 800-38C).
+* @param  aes: AES context.
+* @param  nonce: nonce, from 7 to 13 bytes.
+* @param  nonce_length: length of the nonce.
+* @param  aad: additional authenticated data, not encrypted (it can be NULL if aad_length is 0).
+* @param  aad_length: length of the additional data, below 0xFF00.
+* @param  in: plaintext.
+* @param[out] out: ciphertext. It can be the plaintext buffer.
+* @param  length: number of bytes to encrypt.
+* @param[out] tag: authentication tag.
+* @param  tag_length: length of the tag: 4, 6, 8, 10, 12, 14 or 16 bytes.
+* @param  Callback: function called when the operation is complete, from the BLE TX RX interrupt.
+*         If NULL, the routine returns when the operation is complete.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : The AES unit is in use.
+*/
+uint8_t HAL_RADIO_AesCcmEncrypt(HAL_RADIO_AesType *aes,
+                                const uint8_t *nonce, uint8_t nonce_length,
+                                const uint8_t *aad, uint16_t aad_length,
+                                const uint8_t *in, uint8_t *out, uint16_t length,
+                                uint8_t *tag, uint8_t tag_length,
+                                void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status))
+{
+  return AesCcmStart(aes, AES_MODE_CCM_ENCRYPT, nonce, nonce_length, aad, aad_length,
+                     in, out, length, tag, tag_length, Callback);
+}
+
+/**
+* @brief  This routine decrypts data in CCM mode and checks its authentication tag.
+*         If the tag is wrong, the output is cleared and the status is 0x3D.
+* @param  aes: AES context.
+* @param  nonce: nonce, from 7 to 13 bytes.
+* @param  nonce_length: length of the nonce.
+* @param  aad: additional authenticated data (it can be NULL if aad_length is 0).
+* @param  aad_length: length of the additional data, below 0xFF00.
+* @param  in: ciphertext.
+* @param[out] out: plaintext. It can be the ciphertext buffer.
+* @param  length: number of bytes to decrypt.
+* @param  tag: authentication tag received with the ciphertext.
+* @param  tag_length: length of the tag: 4, 6, 8, 10, 12, 14 or 16 bytes.
+* @param  Callback: function called when the operation is complete, from the BLE TX RX interrupt.
+*         If NULL, the routine returns when the operation is complete.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0x3D : Wrong tag (only if Callback is NULL).
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : The AES unit is in use.
+*/
+uint8_t HAL_RADIO_AesCcmDecrypt(HAL_RADIO_AesType *aes,
+                                const uint8_t *nonce, uint8_t nonce_length,
+                                const uint8_t *aad, uint16_t aad_length,
+                                const uint8_t *in, uint8_t *out, uint16_t length,
+                                uint8_t *tag, uint8_t tag_length,
+                                void (*Callback)(HAL_RADIO_AesType *aes, uint8_t status))
+{
+  return AesCcmStart(aes, AES_MODE_CCM_DECRYPT, nonce, nonce_length, aad, aad_length,
+                     in, out, length, tag, tag_length, Callback);
+}
+
+/**
+* @brief  This routine tells if an operation is running on an AES context.
+* @param  aes: AES context.
+* @retval TRUE until the completion callback has been called.
+*/
+uint8_t HAL_RADIO_AesIsBusy(HAL_RADIO_AesType *aes)
+{
+  return aes->busy;
+}
+
+/**
+* @brief  AES unit interrupt handler. It must be called from BLE_TX_RX_IRQHandler(),
+*         besides RADIO_IRQHandler(), when operations with a completion callback are used.
+* @retval None
+*/
+void HAL_RADIO_AesIRQHandler(void)
+{
+#if !HAL_RADIO_AES_SOFTWARE_ENABLE
+  if((BLUE->INTERRUPT2REG & BLUE_INTERRUPT2REG_AESMANENCINT) == 0U) {
+    return;
+  }
+  BLUE->INTERRUPT2REG = BLUE_INTERRUPT2REG_AESMANENCINT;
+  if(aesActive != NULL_0) {
+    AesStep(aesActive);
+  }
+#endif
+}
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,260 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_radio_afh.c
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP HAL radio adaptive frequency hopping
+  * @details The channel of each event is selected with the Bluetooth Low Energy
+  * channel selection algorithm #1: the unmapped channel is incremented by the hop
+  * value and, if it is not in the channel map, it is remapped on the channels in use.
+  * The packet error rate and the interference level of each channel are collected
+  * from the results of the radio actions. HAL_RADIO_AfhUpdateMap() builds a new
+  * channel map without the bad channels and an instant: both ends of the link install
+  * the new map with HAL_RADIO_AfhSetPendingMap() and switch to it at the same event.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#include "rf_driver_hal_radio_afh.h"
+#include <osal.h>
+
+/* Exchanges needed on a channel to evaluate its packet error rate */
+#define AFH_MIN_PACKETS        (8U)
+
+/* The interference level is an exponential average with a weight of 1/8 */
+#define AFH_RSSI_SHIFT         (3U)
+
+#define AFH_RSSI_INVALID       (127)
+
+#define AFH_IS_USED(map, ch)   ((((map)[(ch) >> 3]) >> ((ch) & 7U)) & 1U)
+
+static void AfhInstallMap(HAL_RADIO_AfhType *afh, uint8_t *chan_remap)
+{
+  uint8_t ch;
+
+  Osal_MemCpy(afh->ChannelMap, chan_remap, sizeof(afh->ChannelMap));
+  afh->ChannelMap[4] &= 0x1F;
+  afh->numUsedChannels = 0;
+  for(ch = 0; ch < HAL_RADIO_AFH_CHANNELS; ch++) {
+    if(AFH_IS_USED(afh->ChannelMap, ch)) {
+      afh->usedChannels[afh->numUsedChannels++] = ch;
+    }
+  }
+}
+
+static uint8_t AfhCountChannels(uint8_t *chan_remap)
+{
+  uint8_t ch, count = 0;
+
+  for(ch = 0; ch < HAL_RADIO_AFH_CHANNELS; ch++) {
+    count += AFH_IS_USED(chan_remap, ch);
+  }
+  return count;
+}
+
+/* Packet error rate in percent, 0 if the channel has not been evaluated */
+static uint8_t AfhChannelPer(HAL_RADIO_AfhChannelStatsType *stats)
+{
+  if(stats->Packets < AFH_MIN_PACKETS) {
+    return 0;
+  }
+  return (uint8_t)(((uint32_t)stats->Errors * 100U) / stats->Packets);
+}
+
+/**
+* @brief  This routine initializes the hopping of a link. All the data channels are in use.
+* @param[out] afh: hopping context.
+* @param  config: hopping configuration. It must be the same on both ends of the link.
+* @param  channel: unmapped channel of the first event, between 0 to 36.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*/
+uint8_t HAL_RADIO_AfhInit(HAL_RADIO_AfhType *afh, HAL_RADIO_AfhConfigType *config, uint8_t channel)
+{
+  uint8_t map[5] = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+  uint8_t ch;
+
+  if((config->Hop < 5) || (config->Hop > 16) || (config->MinChannels < 2) ||
+     (config->MinChannels > HAL_RADIO_AFH_CHANNELS) || (config->ExcludeUpdates == 0) || (channel >= HAL_RADIO_AFH_CHANNELS)) {
+    return INVALID_PARAMETER_C0;
+  }
+
+  Osal_MemSet(afh, 0, sizeof(HAL_RADIO_AfhType));
+  afh->config = *config;
+  for(ch = 0; ch < HAL_RADIO_AFH_CHANNELS; ch++) {
+    afh->stats[ch].Interference = AFH_RSSI_INVALID * 16;
+  }
+  AfhInstallMap(afh, map);
+  /* The first call to HAL_RADIO_AfhNextChannel() returns channel */
+  afh->unmappedChannel = (channel + HAL_RADIO_AFH_CHANNELS - config->Hop) % HAL_RADIO_AFH_CHANNELS;
+  afh->EventCounter = 0xFFFF;
+
+  return SUCCESS_0;
+}
+
+/**
+* @brief  This routine moves the link to its next event and returns the channel to use.
+*         The pending channel map is installed when the instant is reached.
+*         It must be called once per event, on both ends of the link, before programming the
+*         radio actions of the event (e.g. with HAL_RADIO_LinkSetChannel()).
+* @param  afh: hopping context.
+* @retval Channel of the event, between 0 to 36.
+*/
+uint8_t HAL_RADIO_AfhNextChannel(HAL_RADIO_AfhType *afh)
+{
+  uint8_t unmapped;
+
+  afh->EventCounter++;
+  if(afh->PendingValid && ((int16_t)(afh->EventCounter - afh->Instant) >= 0)) {
+    AfhInstallMap(afh, afh->PendingMap);
+    afh->PendingValid = FALSE;
+  }
+
+  unmapped = (afh->unmappedChannel + afh->config.Hop) % HAL_RADIO_AFH_CHANNELS;
+  afh->unmappedChannel = unmapped;
+  if(AFH_IS_USED(afh->ChannelMap, unmapped)) {
+    afh->Channel = unmapped;
+  }
+  else {
+    afh->Channel = afh->usedChannels[unmapped % afh->numUsedChannels];
+  }
+  return afh->Channel;
+}
+
+/**
+* @brief  This routine records the result of an RX action executed on the channel of the current event.
+*         It can be called from the data routine of the action.
+*         The RSSI measured without any valid packet is averaged as the interference level of the channel.
+* @param  afh: hopping context.
+* @param  p: RX action packet.
+* @retval None
+*/
+void HAL_RADIO_AfhReportRx(HAL_RADIO_AfhType *afh, ActionPacket *p)
+{
+  HAL_RADIO_AfhChannelStatsType *stats = &afh->stats[afh->Channel];
+  int16_t rssi;
+
+  stats->Packets++;
+  if((p->status & BLUE_INTERRUPT1REG_RCVOK) == 0) {
+    stats->Errors++;
+    if(p->rssi != AFH_RSSI_INVALID) {
+      rssi = (int16_t)p->rssi * 16;
+      if(stats->Interference == AFH_RSSI_INVALID * 16) {
+        stats->Interference = rssi;
+      }
+      else {
+        stats->Interference += (rssi - stats->Interference) >> AFH_RSSI_SHIFT;
+      }
+    }
+  }
+}
+
+/**
+* @brief  This routine records the result of a TX action with acknowledgement executed on the
+*         channel of the current event.
+* @param  afh: hopping context.
+* @param  acked: TRUE if the acknowledgement has been received.
+* @retval None
+*/
+void HAL_RADIO_AfhReportTx(HAL_RADIO_AfhType *afh, uint8_t acked)
+{
+  afh->stats[afh->Channel].Packets++;
+  if(acked == FALSE) {
+    afh->stats[afh->Channel].Errors++;
+  }
+}
+
+/**
+* @brief  This routine builds a new channel map from the statistics collected since the last call.
+*         A channel is excluded if its packet error rate is above PerThreshold or its interference
+*         level is above RssiThreshold. An excluded channel is used again after ExcludeUpdates updates,
+*         to be evaluated again. The channels without enough samples are kept in use.
+*         If less than MinChannels channels remain, the best excluded channels are added back.
+*         The statistics are cleared.
+* @param  afh: hopping context.
+* @param[out] chan_remap: new channel map, same format as RADIO_SetChannelMap().
+* @param[out] instant: event counter value from which the new map must be used.
+* @retval TRUE if the new channel map differs from the current one. The application must then send
+*         the map and the instant to the other end of the link, and both ends call HAL_RADIO_AfhSetPendingMap().
+*/
+uint8_t HAL_RADIO_AfhUpdateMap(HAL_RADIO_AfhType *afh, uint8_t *chan_remap, uint16_t *instant)
+{
+  HAL_RADIO_AfhChannelStatsType *stats;
+  uint8_t ch, best, bestPer, per, count;
+  uint8_t changed;
+
+  Osal_MemSet(chan_remap, 0, 5);
+  for(ch = 0; ch < HAL_RADIO_AFH_CHANNELS; ch++) {
+    stats = &afh->stats[ch];
+    if(stats->Excluded != 0) {
+      /* Not used since the last update: no new sample */
+      stats->Excluded--;
+    }
+    else if((AfhChannelPer(stats) > afh->config.PerThreshold) ||
+            ((stats->Interference != AFH_RSSI_INVALID * 16) && (stats->Interference > afh->config.RssiThreshold * 16))) {
+      stats->Excluded = afh->config.ExcludeUpdates;
+    }
+    if(stats->Excluded == 0) {
+      chan_remap[ch >> 3] |= (1U << (ch & 7U));
+    }
+  }
+
+  count = AfhCountChannels(chan_remap);
+  while(count < afh->config.MinChannels) {
+    best = HAL_RADIO_AFH_CHANNELS;
+    bestPer = 0xFF;
+    for(ch = 0; ch < HAL_RADIO_AFH_CHANNELS; ch++) {
+      per = AfhChannelPer(&afh->stats[ch]);
+      if(!AFH_IS_USED(chan_remap, ch) && (per < bestPer)) {
+        best = ch;
+        bestPer = per;
+      }
+    }
+    chan_remap[best >> 3] |= (1U << (best & 7U));
+    afh->stats[best].Excluded = 0;
+    count++;
+  }
+
+  for(ch = 0; ch < HAL_RADIO_AFH_CHANNELS; ch++) {
+    afh->stats[ch].Packets = 0;
+    afh->stats[ch].Errors = 0;
+    afh->stats[ch].Interference = AFH_RSSI_INVALID * 16;
+  }
+
+  changed = (Osal_MemCmp(chan_remap, afh->ChannelMap, 5) != 0);
+  *instant = afh->EventCounter + afh->config.InstantOffset;
+  return changed;
+}
+
+/**
+* @brief  This routine schedules the use of a new channel map from the instant.
+*         It must be called on both ends of the link with the same map and instant.
+* @param  afh: hopping context.
+* @param  chan_remap: new channel map, same format as RADIO_SetChannelMap().
+* @param  instant: event counter value from which the new map is used.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter, the map has less than 2 channels.
+*/
+uint8_t HAL_RADIO_AfhSetPendingMap(HAL_RADIO_AfhType *afh, uint8_t *chan_remap, uint16_t instant)
+{
+  if(AfhCountChannels(chan_remap) < 2) {
+    return INVALID_PARAMETER_C0;
+  }
+  Osal_MemCpy(afh->PendingMap, chan_remap, sizeof(afh->PendingMap));
+  afh->Instant = instant;
+  afh->PendingValid = TRUE;
+
+  return SUCCESS_0;
+}
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,492 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_hal_radio_arq.c
+  * @author  RF Application Team
+  * @brief   BlueNRG-LP HAL radio reliable transport (ARQ)
+  * @details Selective repeat ARQ on top of the ActionPacket chaining.
+  * The sender executes a loop made of a TX action (data frame) and an RX action
+  * (acknowledgement). The receiver executes the opposite loop.
+  * The acknowledgement carries the next in-order sequence number expected by the
+  * receiver and a bitmap of the frames received out of order.
+  * The protocol runs in the condRoutine() and dataRoutine() callbacks, so that
+  * the next frame or a retransmission is sent back-to-back, without returning
+  * to the application.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#include "rf_driver_hal_radio_arq.h"
+#include "rf_driver_hal_vtimer.h"
+#include <osal.h>
+
+/* Frame format: header, length, type, sequence number, payload */
+#define ARQ_TYPE_OFFSET     (HEADER_LENGTH)
+#define ARQ_SEQ_OFFSET      (HEADER_LENGTH + 1U)
+#define ARQ_PAYLOAD_OFFSET  (HEADER_LENGTH + HAL_RADIO_ARQ_HEADER_LENGTH)
+
+#define ARQ_TYPE_DATA       (0x01U)
+#define ARQ_TYPE_ACK        (0x02U)
+
+/* The acknowledgement payload is the selective acknowledgement bitmap */
+#define ARQ_ACK_LENGTH      (HAL_RADIO_ARQ_HEADER_LENGTH + 1U)
+
+#define ARQ_SLOT_FREE       (0U)
+#define ARQ_SLOT_PENDING    (1U)
+#define ARQ_SLOT_ACKED      (2U)
+
+#define ARQ_SLOT(seq)       ((uint8_t)(seq) % HAL_RADIO_ARQ_MAX_WINDOW)
+
+/* Room taken in the FIFO by a frame delivered to the application */
+#define ARQ_FIFO_ITEM_SIZE  (HAL_RADIO_ARQ_MAX_PAYLOAD + 8U)
+
+/* Only one ARQ endpoint can use the radio at a time */
+static HAL_RADIO_ArqType *arqActive;
+
+static uint8_t ArqCondRoutineTrue(ActionPacket* p)
+{
+  return TRUE;
+}
+
+static void ArqSetupRadio(HAL_RADIO_ArqType *arq)
+{
+  uint8_t map[5]= {0xFF,0xFF,0xFF,0xFF,0xFF};
+  RADIO_SetChannelMap(0, &map[0]);
+  RADIO_SetChannel(0, arq->config.Channel, 0);
+  RADIO_SetTxAttributes(0, arq->config.NetworkID, 0x555555);
+  RADIO_SetGlobalReceiveTimeout(arq->config.ReceiveTimeout);
+}
+
+/* Mark as acknowledged the frames before expected and the ones set in bitmap,
+   then release the acknowledged frames at the beginning of the window. */
+static void ArqProcessAck(HAL_RADIO_ArqType *arq, uint8_t expected, uint8_t bitmap)
+{
+  uint8_t base = arq->base;
+  uint8_t inFlight = (uint8_t)(arq->tail - base);
+  uint8_t acked = (uint8_t)(expected - base);
+  uint8_t i, seq;
+
+  /* Stale or invalid acknowledgement */
+  if(acked > inFlight) {
+    return;
+  }
+
+  for(i = 0; i < acked; i++) {
+    arq->slotState[ARQ_SLOT(base + i)] = ARQ_SLOT_ACKED;
+  }
+  for(i = 0; i < 8; i++) {
+    seq = (uint8_t)(expected + 1 + i);
+    if(((bitmap >> i) & 1U) && ((uint8_t)(seq - base) < inFlight)) {
+      arq->slotState[ARQ_SLOT(seq)] = ARQ_SLOT_ACKED;
+    }
+  }
+
+  while((base != arq->tail) && (arq->slotState[ARQ_SLOT(base)] == ARQ_SLOT_ACKED)) {
+    arq->slotState[ARQ_SLOT(base)] = ARQ_SLOT_FREE;
+    base++;
+    arq->status.FramesAcked++;
+  }
+  arq->base = base;
+}
+
+/* Select the next frame to transmit: the first frame not acknowledged after the
+   last one transmitted, so that a lost acknowledgement does not stall the window. */
+static uint8_t ArqNextFrame(HAL_RADIO_ArqType *arq, uint8_t *next)
+{
+  uint8_t base = arq->base;
+  uint8_t inFlight = (uint8_t)(arq->tail - base);
+  uint8_t start = (uint8_t)(arq->txSeq + 1 - base);
+  uint8_t i, seq;
+
+  if(start >= inFlight) {
+    start = 0;
+  }
+  for(i = 0; i < inFlight; i++) {
+    seq = (uint8_t)(base + (start + i) % inFlight);
+    if(arq->slotState[ARQ_SLOT(seq)] == ARQ_SLOT_PENDING) {
+      if(arq->slotRetries[ARQ_SLOT(seq)] >= arq->config.MaxRetries) {
+        arq->status.Error = TRUE;
+        return FALSE;
+      }
+      if(arq->slotRetries[ARQ_SLOT(seq)] != 0) {
+        arq->status.Retransmissions++;
+      }
+      arq->slotRetries[ARQ_SLOT(seq)]++;
+      arq->txSeq = seq;
+      *next = seq;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static uint8_t ArqSenderCondRoutine(ActionPacket* p)
+{
+  HAL_RADIO_ArqType *arq = arqActive;
+  ActionPacket *tx = &arq->actionPacket[0];
+  uint8_t seq;
+
+  if(((p->status & BLUE_INTERRUPT1REG_RCVOK) != 0) &&
+     (p->data[1] >= ARQ_ACK_LENGTH) && (p->data[ARQ_TYPE_OFFSET] == ARQ_TYPE_ACK)) {
+    ArqProcessAck(arq, p->data[ARQ_SEQ_OFFSET], p->data[ARQ_PAYLOAD_OFFSET]);
+  }
+
+  if(ArqNextFrame(arq, &seq) == FALSE) {
+    /* All the frames are acknowledged or the link is lost */
+    return FALSE;
+  }
+  tx->data = arq->slot[ARQ_SLOT(seq)];
+  tx->trans_packet.DATAPTR = BLUE_DATA_PTR_CAST(tx->data);
+  return TRUE;
+}
+
+static uint8_t ArqSenderTxDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  /* The TX packet is executed again for each frame: no more PLL calibration */
+  p->ActionTag &= ~PLL_TRIG;
+  p->trans_packet.BYTE4 &= ~TXRXPACK_BYTE4_CALREQ_Msk;
+  arqActive->status.FramesSent++;
+  return TRUE;
+}
+
+static uint8_t ArqSenderRxDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  if(next == NULL_0) {
+    arqActive->status.Active = FALSE;
+  }
+  return TRUE;
+}
+
+static uint8_t ArqReceiverCondRoutine(ActionPacket* p)
+{
+  HAL_RADIO_ArqType *arq = arqActive;
+  uint8_t seq, offset;
+
+  if(arq->stopRequest) {
+    p->next_false = NULL_0;
+    return FALSE;
+  }
+
+  /* Listen again if no valid data frame has been received */
+  if(((p->status & BLUE_INTERRUPT1REG_RCVOK) == 0) ||
+     (p->data[1] < HAL_RADIO_ARQ_HEADER_LENGTH) || (p->data[ARQ_TYPE_OFFSET] != ARQ_TYPE_DATA)) {
+    return FALSE;
+  }
+
+  seq = p->data[ARQ_SEQ_OFFSET];
+  offset = (uint8_t)(seq - arq->expected);
+  if(offset < arq->config.Window) {
+    if((arq->rxBitmap & (1U << offset)) == 0) {
+      /* Do not acknowledge a frame that could not be delivered */
+      if((uint16_t)(arq->fifo->max_size - fifo_spsc_size(arq->fifo)) < (arq->config.Window * ARQ_FIFO_ITEM_SIZE)) {
+        return FALSE;
+      }
+      arq->rxBitmap |= (1U << offset);
+      arq->rxStore = TRUE;
+    }
+    else {
+      arq->status.Duplicates++;
+    }
+  }
+  else if((uint8_t)(arq->expected - seq) <= arq->config.Window) {
+    /* Already delivered: the acknowledgement has been lost, send it again */
+    arq->status.Duplicates++;
+  }
+  else {
+    return FALSE;
+  }
+
+  if(arq->rxDeliver == 0) {
+    arq->rxDeliverFrom = arq->expected;
+  }
+  while((arq->rxBitmap & 1U) != 0) {
+    arq->rxBitmap >>= 1;
+    arq->expected++;
+    arq->rxDeliver++;
+  }
+
+  arq->ackBuffer[0] = 0;
+  arq->ackBuffer[1] = ARQ_ACK_LENGTH;
+  arq->ackBuffer[ARQ_TYPE_OFFSET] = ARQ_TYPE_ACK;
+  arq->ackBuffer[ARQ_SEQ_OFFSET] = arq->expected;
+  arq->ackBuffer[ARQ_PAYLOAD_OFFSET] = (uint8_t)(arq->rxBitmap >> 1);
+  return TRUE;
+}
+
+static uint8_t ArqReceiverDataRoutine(ActionPacket* p, ActionPacket* next)
+{
+  HAL_RADIO_ArqType *arq = arqActive;
+  uint8_t *frame;
+  uint8_t length;
+
+  /* The RX packet is executed again for each frame: no more PLL calibration */
+  p->ActionTag &= ~PLL_TRIG;
+  p->trans_packet.BYTE4 &= ~TXRXPACK_BYTE4_CALREQ_Msk;
+
+  if(arq->rxStore) {
+    arq->rxStore = FALSE;
+    length = p->data[1];
+    if(length > (HAL_RADIO_ARQ_HEADER_LENGTH + HAL_RADIO_ARQ_MAX_PAYLOAD)) {
+      length = HAL_RADIO_ARQ_HEADER_LENGTH + HAL_RADIO_ARQ_MAX_PAYLOAD;
+    }
+    frame = arq->slot[ARQ_SLOT(p->data[ARQ_SEQ_OFFSET])];
+    Osal_MemCpy(frame, p->data, HEADER_LENGTH + length);
+    /* The delivery reads the payload length from the slot */
+    frame[1] = length;
+  }
+
+  while(arq->rxDeliver != 0) {
+    frame = arq->slot[ARQ_SLOT(arq->rxDeliverFrom)];
+    length = frame[1] - HAL_RADIO_ARQ_HEADER_LENGTH;
+    /* The room has been checked before acknowledging the frame */
+    fifo_spsc_put_var_len_item(arq->fifo, 0, NULL_0, length, &frame[ARQ_PAYLOAD_OFFSET]);
+    arq->status.FramesReceived++;
+    arq->rxDeliverFrom++;
+    arq->rxDeliver--;
+  }
+
+  if(next == NULL_0) {
+    arq->status.Active = FALSE;
+  }
+  return TRUE;
+}
+
+static uint8_t ArqAckCondRoutine(ActionPacket* p)
+{
+  if(arqActive->stopRequest) {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+* @brief  This routine initializes an ARQ endpoint.
+* @param[out] arq: ARQ context.
+* @param  config: link configuration.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*/
+uint8_t HAL_RADIO_ArqInit(HAL_RADIO_ArqType *arq, HAL_RADIO_ArqConfigType *config)
+{
+  if((config->Channel > 39) || (config->Window == 0) ||
+     (config->Window > HAL_RADIO_ARQ_MAX_WINDOW) || (config->MaxRetries == 0)) {
+    return INVALID_PARAMETER_C0;
+  }
+
+  Osal_MemSet(arq, 0, sizeof(HAL_RADIO_ArqType));
+  arq->config = *config;
+
+  return SUCCESS_0;
+}
+
+/**
+* @brief  This routine queues a frame in the sending window.
+*         The frame is copied, so the buffer can be reused when the function returns.
+*         It can be called while the transmission is running: the frame is sent in the same radio activity.
+* @param  arq: ARQ context.
+* @param  data: payload of the frame.
+* @param  length: length of the payload, up to HAL_RADIO_ARQ_MAX_PAYLOAD bytes.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : The window is full, the frame has not been queued.
+*/
+uint8_t HAL_RADIO_ArqSend(HAL_RADIO_ArqType *arq, uint8_t *data, uint8_t length)
+{
+  uint8_t seq = arq->tail;
+  uint8_t *frame;
+
+  if(length > HAL_RADIO_ARQ_MAX_PAYLOAD) {
+    return INVALID_PARAMETER_C0;
+  }
+  if((uint8_t)(seq - arq->base) >= arq->config.Window) {
+    return RADIO_BUSY_C4;
+  }
+
+  frame = arq->slot[ARQ_SLOT(seq)];
+  frame[0] = 0;
+  frame[1] = HAL_RADIO_ARQ_HEADER_LENGTH + length;
+  frame[ARQ_TYPE_OFFSET] = ARQ_TYPE_DATA;
+  frame[ARQ_SEQ_OFFSET] = seq;
+  Osal_MemCpy(&frame[ARQ_PAYLOAD_OFFSET], data, length);
+  arq->slotRetries[ARQ_SLOT(seq)] = 0;
+  arq->slotState[ARQ_SLOT(seq)] = ARQ_SLOT_PENDING;
+
+  /* The frame is visible to the radio ISR only from here: the slot must be written before */
+  FIFO_SPSC_BARRIER();
+  arq->tail = seq + 1;
+
+  return SUCCESS_0;
+}
+
+/**
+* @brief  This routine starts the transmission of the frames queued with HAL_RADIO_ArqSend().
+*         Each data frame is followed by an RX window for the acknowledgement. The radio activity
+*         ends when all the frames have been acknowledged, or when a frame has been transmitted
+*         MaxRetries times without acknowledgement (the Error flag of the status is then set).
+* @param  arq: ARQ context.
+* @param  wakeup_time: Time of the first transmission in us. This is relative time regarding now.
+*         Minimum wakeup_time of 250 us. TBR
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter, no frame to send or link lost.
+*           - 0xC4 : Radio is busy, transmission has not been triggered.
+*/
+uint8_t HAL_RADIO_ArqStartTransmit(HAL_RADIO_ArqType *arq, uint32_t wakeup_time)
+{
+  uint8_t returnValue;
+  uint32_t dummy,time;
+  uint8_t seq;
+
+  time = (uint32_t)TIMER_GetCurrentSysTime() + TIMER_UsToSystime(wakeup_time);
+
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    return RADIO_BUSY_C4;
+  }
+
+  arqActive = arq;
+  arq->txSeq = (uint8_t)(arq->base - 1);
+  if((arq->status.Error != FALSE) || (ArqNextFrame(arq, &seq) == FALSE)) {
+    return INVALID_PARAMETER_C0;
+  }
+
+  ArqSetupRadio(arq);
+  arq->status.Active = TRUE;
+
+  arq->actionPacket[0].StateMachineNo = STATE_MACHINE_0;
+  arq->actionPacket[0].ActionTag = TXRX | PLL_TRIG;
+  arq->actionPacket[0].WakeupTime = time;
+  arq->actionPacket[0].MaxReceiveLength = 0; /* does not affect for Tx */
+  arq->actionPacket[0].data = arq->slot[ARQ_SLOT(seq)];
+  arq->actionPacket[0].next_true = &arq->actionPacket[1];
+  arq->actionPacket[0].next_false = &arq->actionPacket[1];
+  arq->actionPacket[0].condRoutine = ArqCondRoutineTrue;
+  arq->actionPacket[0].dataRoutine = ArqSenderTxDataRoutine;
+
+  arq->actionPacket[1].StateMachineNo = STATE_MACHINE_0;
+  arq->actionPacket[1].ActionTag = 0;
+  arq->actionPacket[1].WakeupTime = time;
+  arq->actionPacket[1].MaxReceiveLength = ARQ_ACK_LENGTH;
+  arq->actionPacket[1].data = arq->radioBuffer;
+  arq->actionPacket[1].next_true = &arq->actionPacket[0];
+  arq->actionPacket[1].next_false = NULL_0;
+  arq->actionPacket[1].condRoutine = ArqSenderCondRoutine;
+  arq->actionPacket[1].dataRoutine = ArqSenderRxDataRoutine;
+
+  RADIO_SetReservedArea(&arq->actionPacket[0]);
+  RADIO_SetReservedArea(&arq->actionPacket[1]);
+  returnValue = RADIO_MakeActionPacketPending(&arq->actionPacket[0]);
+  if(returnValue != SUCCESS_0) {
+    arq->status.Active = FALSE;
+  }
+
+  return returnValue;
+}
+
+/**
+* @brief  This routine starts the reception of the frames.
+*         The radio listens until a data frame is received, acknowledges it and listens again,
+*         until HAL_RADIO_ArqStopReceive() is called. The frames are delivered in order and without
+*         duplicates to the FIFO, one variable length item per frame, to be read with fifo_spsc_get_var_len_item().
+*         A frame is not acknowledged if the FIFO has no room for a full window: the sender retransmits it later.
+* @param  arq: ARQ context.
+* @param  wakeup_time: Time of the first RX window in us. This is relative time regarding now.
+*         Minimum wakeup_time of 250 us. TBR
+* @param  fifo: FIFO where the received frames are stored by the radio ISR.
+* @retval uint8_t return value
+*           - 0x00 : Success.
+*           - 0xC0 : Invalid parameter.
+*           - 0xC4 : Radio is busy, receiving has not been triggered.
+*/
+uint8_t HAL_RADIO_ArqStartReceive(HAL_RADIO_ArqType *arq, uint32_t wakeup_time, circular_fifo_spsc_t *fifo)
+{
+  uint8_t returnValue;
+  uint32_t dummy,time;
+
+  time = (uint32_t)TIMER_GetCurrentSysTime() + TIMER_UsToSystime(wakeup_time);
+
+  if(fifo == NULL_0) {
+    return INVALID_PARAMETER_C0;
+  }
+  if(RADIO_GetStatus(&dummy) != BLUE_IDLE_0) {
+    return RADIO_BUSY_C4;
+  }
+
+  arqActive = arq;
+  arq->fifo = fifo;
+  arq->stopRequest = FALSE;
+  ArqSetupRadio(arq);
+  arq->status.Active = TRUE;
+
+  arq->actionPacket[0].StateMachineNo = STATE_MACHINE_0;
+  arq->actionPacket[0].ActionTag = PLL_TRIG;
+  arq->actionPacket[0].WakeupTime = time;
+  arq->actionPacket[0].MaxReceiveLength = HAL_RADIO_ARQ_HEADER_LENGTH + HAL_RADIO_ARQ_MAX_PAYLOAD;
+  arq->actionPacket[0].data = arq->radioBuffer;
+  arq->actionPacket[0].next_true = &arq->actionPacket[1];
+  arq->actionPacket[0].next_false = &arq->actionPacket[0];
+  arq->actionPacket[0].condRoutine = ArqReceiverCondRoutine;
+  arq->actionPacket[0].dataRoutine = ArqReceiverDataRoutine;
+
+  arq->actionPacket[1].StateMachineNo = STATE_MACHINE_0;
+  arq->actionPacket[1].ActionTag = TXRX;
+  arq->actionPacket[1].WakeupTime = time;
+  arq->actionPacket[1].MaxReceiveLength = 0; /* does not affect for Tx */
+  arq->actionPacket[1].data = arq->ackBuffer;
+  arq->actionPacket[1].next_true = &arq->actionPacket[0];
+  arq->actionPacket[1].next_false = NULL_0;
+  arq->actionPacket[1].condRoutine = ArqAckCondRoutine;
+  arq->actionPacket[1].dataRoutine = ArqReceiverDataRoutine;
+
+  RADIO_SetReservedArea(&arq->actionPacket[0]);
+  RADIO_SetReservedArea(&arq->actionPacket[1]);
+  returnValue = RADIO_MakeActionPacketPending(&arq->actionPacket[0]);
+  if(returnValue != SUCCESS_0) {
+    arq->status.Active = FALSE;
+  }
+
+  return returnValue;
+}
+
+/**
+* @brief  This routine stops the reception started with HAL_RADIO_ArqStartReceive()
+*         at the end of the current radio action.
+* @param  arq: ARQ context.
+* @retval None
+*/
+void HAL_RADIO_ArqStopReceive(HAL_RADIO_ArqType *arq)
+{
+  arq->stopRequest = TRUE;
+}
+
+/**
+* @brief  This routine returns the number of frames that can be queued with HAL_RADIO_ArqSend().
+* @param  arq: ARQ context.
+* @retval Number of free slots in the sending window.
+*/
+uint8_t HAL_RADIO_ArqGetFreeSlots(HAL_RADIO_ArqType *arq)
+{
+  return arq->config.Window - (uint8_t)(arq->tail - arq->base);
+}
+
+/**
+* @brief  This routine returns the counters of an ARQ endpoint.
+* @param  arq: ARQ context.
+* @param[out] status: ARQ status.
+* @retval None
+*/
+void HAL_RADIO_ArqGetStatus(HAL_RADIO_ArqType *arq, HAL_RADIO_ArqStatusType *status)
+{
+  *status = arq->status;
+}
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -69,10 +69,16 @@
   * @{
   */
 
+#if TIMER_SIM_ENABLE
+/* Simulated timer events are delivered synchronously by TIMER_SIM_Advance() */
+#define ATOMIC_SECTION_BEGIN()
+#define ATOMIC_SECTION_END()
+#else
 #define ATOMIC_SECTION_BEGIN() uint32_t uwPRIMASK_Bit = __get_PRIMASK(); \
                                 __disable_irq(); \
 /* Must be called in the same scope of ATOMIC_SECTION_BEGIN */
 #define ATOMIC_SECTION_END() __set_PRIMASK(uwPRIMASK_Bit)
+#endif
 
 #define MAX(a,b) ((a) < (b) )? (b) : (a)
 #define MIN(a,b) ((a) < (b) )? (a) : (b)
@@ -82,6 +88,20 @@
 
 #define BLE_TX_RX_EXCEPTION_NUMBER 18
 
+#if VTIMER_STATS_ENABLE
+/* Must be called right after ATOMIC_SECTION_BEGIN, in the same scope */
+#define STATS_MASKED_BEGIN() uint32_t maskedStart = TIMER_GetCurrentMachineTime()
+/* Must be called right before ATOMIC_SECTION_END */
+#define STATS_MASKED_END() _stats_record_masked(TIMER_GetCurrentMachineTime() - maskedStart)
+#define STATS_RECORD_CALLBACK(timerHandle) _stats_record_callback(timerHandle)
+#define STATS_RECORD_QUEUE_DEPTH() _stats_record_queue_depth()
+#else
+#define STATS_MASKED_BEGIN()
+#define STATS_MASKED_END()
+#define STATS_RECORD_CALLBACK(timerHandle)
+#define STATS_RECORD_QUEUE_DEPTH()
+#endif
+
 /**
   * @}
   */
@@ -107,6 +127,9 @@ it is not sure the timer can be cleared properly */
 /* Threshold to take into account the calibration duration. */
 #define CALIB_SAFE_THR (370)
 
+/* Interval in STU between two calibrations started during the active phase */
+#define ACTIVE_CALIB_INTERVAL (TIMER_SYSTICK_PER_FIVE_SECONDS)
+
 /* Extra margin to consider before going in low power mode */
 #define LOW_POWER_THR (30)
 
@@ -133,6 +156,17 @@ typedef struct HAL_VTIMER_ContextS {
   uint8_t served_count; /*!< Progressive number to indicate served expired timers */
   uint8_t wakeup_calibration; /*!< Flag to indicate if start a calibration after  wakeup */
   uint8_t stop_notimer_action; /*!< Flag to indicate DEEPSTOP no timer action */
+  uint32_t coalescedWakeups; /*!< Number of wakeups saved by delaying timers within their slack */
+  uint64_t wakeupTime; /*!< Wakeup time programmed for the host timers, 0 if a timer is already expired */
+  uint32_t initialCalibrationInterval; /*!< Calibration interval in STU set at initialization */
+  BOOL adaptiveCalibration; /*!< Flag to indicate that the calibration interval follows the clock drift */
+  uint32_t minCalibrationInterval; /*!< Adaptive calibration interval lower bound in STU */
+  uint32_t maxCalibrationInterval; /*!< Adaptive calibration interval upper bound in STU */
+  uint32_t driftThreshold; /*!< Drift in ppm above which the calibration interval is shortened */
+  uint32_t lastDrift; /*!< Drift in ppm measured by the last calibration */
+  uint32_t maxDrift; /*!< Largest drift in ppm measured */
+  uint32_t lastDriftError; /*!< Time base error in STU estimated over the last calibration interval */
+  uint32_t calibrationCount; /*!< Number of periodic calibrations completed */
 } HAL_VTIMER_ContextType;
 
 typedef struct VTIMER_RadioHandleTypeS {
@@ -167,6 +201,10 @@ static uint8_t waitCal;
 
 static TIMER_CalibrationType calibrationData;
 
+#if VTIMER_STATS_ENABLE
+static HAL_VTIMER_StatsType vtimerStats;
+#endif
+
 /**
   * @}
   */
@@ -228,6 +266,141 @@ static void calibration_callback (void *handle)
   HAL_VTIMER_Context.calibration_in_progress = TRUE;
 }
 
+#if VTIMER_HEAP_ENABLE
+/* Pairing heap ordered by expiryTime. The root is the next timer to expire.
+   next is the right sibling, prev is the left sibling or the parent for the
+   leftmost child, so that any node can be unlinked in O(1).
+   Only active timers are in the heap: HAL_VTIMER_StopTimer() does not look at the links
+   of a timer not active. An active timer is in the heap if it is the root or if its prev
+   pointer is set, the expired ones waiting for their callback have it cleared. */
+static uint32_t heapCount;
+
+static VTIMER_HandleType * _heap_meld(VTIMER_HandleType *a, VTIMER_HandleType *b)
+{
+  VTIMER_HandleType *tmp;
+  
+  if (b->expiryTime < a->expiryTime) {
+    tmp = a;
+    a = b;
+    b = tmp;
+  }
+  b->prev = a;
+  b->next = a->child;
+  if (a->child != NULL) {
+    a->child->prev = b;
+  }
+  a->child = b;
+  
+  return a;
+}
+
+/* Two-pass merge of a list of siblings. The prev field is used as a stack in the first pass. */
+static VTIMER_HandleType * _heap_merge_pairs(VTIMER_HandleType *first)
+{
+  VTIMER_HandleType *a, *b, *rest;
+  VTIMER_HandleType *pairs = NULL;
+  VTIMER_HandleType *returnValue = NULL;
+  
+  while (first != NULL) {
+    a = first;
+    b = a->next;
+    a->prev = a->next = NULL;
+    if (b == NULL) {
+      rest = NULL;
+    }
+    else {
+      rest = b->next;
+      b->prev = b->next = NULL;
+      a = _heap_meld(a, b);
+    }
+    a->prev = pairs;
+    pairs = a;
+    first = rest;
+  }
+  
+  while (pairs != NULL) {
+    a = pairs;
+    pairs = a->prev;
+    a->prev = NULL;
+    returnValue = (returnValue == NULL) ? a : _heap_meld(a, returnValue);
+  }
+  
+  return returnValue;
+}
+
+static VTIMER_HandleType * _remove_timer_in_queue(VTIMER_HandleType *rootNode, VTIMER_HandleType *handle)
+{
+  VTIMER_HandleType *subHeap;
+  VTIMER_HandleType *returnValue = rootNode;
+  
+  if (handle == rootNode) {
+    returnValue = _heap_merge_pairs(handle->child);
+  }
+  else if (handle->prev != NULL) {
+    if (handle->prev->child == handle) {
+      handle->prev->child = handle->next;
+    }
+    else {
+      handle->prev->next = handle->next;
+    }
+    if (handle->next != NULL) {
+      handle->next->prev = handle->prev;
+    }
+    subHeap = _heap_merge_pairs(handle->child);
+    if (subHeap != NULL) {
+      returnValue = _heap_meld(rootNode, subHeap);
+    }
+  }
+  else {
+    /* Not found */
+    return returnValue;
+  }
+  
+  handle->prev = handle->next = handle->child = NULL;
+  heapCount--;
+  return returnValue;
+}
+
+static VTIMER_HandleType * _insert_timer_in_queue(VTIMER_HandleType *rootNode, VTIMER_HandleType *handle)
+{
+  handle->prev = handle->next = handle->child = NULL;
+  heapCount++;
+  
+  if (rootNode == NULL) {
+    return handle;
+  }
+  return _heap_meld(rootNode, handle);
+}
+
+/* Pre-order walk of the heap restricted to the timers expiring not later than limit.
+   Subtrees whose root expires after limit are skipped as a whole. */
+static VTIMER_HandleType * _next_timer_in_window(VTIMER_HandleType *node, uint64_t limit)
+{
+  VTIMER_HandleType *next = node->child;
+  
+  while (1) {
+    for (; next != NULL; next = next->next) {
+      if (next->expiryTime <= limit) {
+        return next;
+      }
+    }
+    if (node->prev == NULL) {
+      /* Back to the root */
+      return NULL;
+    }
+    next = node->next;
+    /* Climb to the parent */
+    while (node->prev->child != node) {
+      node = node->prev;
+    }
+    node = node->prev;
+  }
+}
+
+#define QUEUE_HAS_SINGLE_TIMER(root) ((root)->child == NULL)
+
+#else
+
 static VTIMER_HandleType * _remove_timer_in_queue(VTIMER_HandleType *rootNode, VTIMER_HandleType *handle)
 {
   VTIMER_HandleType *current = rootNode;
@@ -277,31 +450,137 @@ static VTIMER_HandleType * _insert_timer_in_queue(VTIMER_HandleType *rootNode, V
   return returnValue;
 }
 
+static VTIMER_HandleType * _next_timer_in_window(VTIMER_HandleType *node, uint64_t limit)
+{
+  node = node->next;
+  if ((node != NULL) && (node->expiryTime <= limit)) {
+    return node;
+  }
+  return NULL;
+}
+
+#define QUEUE_HAS_SINGLE_TIMER(root) ((root)->next == NULL)
+
+#endif /* VTIMER_HEAP_ENABLE */
+
+/* Measure the drift of the low speed clock frequency since the previous calibration
+   and, if the adaptive policy is enabled, stretch or shrink the calibration interval. */
+static void _update_calibration_interval(TIMER_CalibrationType *previousData)
+{
+  uint32_t interval = HAL_VTIMER_Context.PeriodicCalibrationInterval;
+  uint64_t elapsed = calibrationData.last_calibration_time - previousData->last_calibration_time;
+  uint32_t diff;
+  
+  diff = (calibrationData.freq > previousData->freq) ? (calibrationData.freq - previousData->freq) :
+                                                       (previousData->freq - calibrationData.freq);
+  HAL_VTIMER_Context.lastDrift = (uint32_t)(((uint64_t)diff*1000000U)/previousData->freq);
+  HAL_VTIMER_Context.maxDrift = MAX(HAL_VTIMER_Context.maxDrift, HAL_VTIMER_Context.lastDrift);
+  HAL_VTIMER_Context.lastDriftError = (uint32_t)((elapsed*HAL_VTIMER_Context.lastDrift)/1000000U);
+  HAL_VTIMER_Context.calibrationCount++;
+  
+  if (HAL_VTIMER_Context.adaptiveCalibration == FALSE) {
+    return;
+  }
+  if (HAL_VTIMER_Context.lastDrift > HAL_VTIMER_Context.driftThreshold) {
+    interval = MAX(interval/2, HAL_VTIMER_Context.minCalibrationInterval);
+  }
+  else if (HAL_VTIMER_Context.lastDrift < HAL_VTIMER_Context.driftThreshold/4) {
+    interval = ((interval*2ULL) > HAL_VTIMER_Context.maxCalibrationInterval) ? \
+               HAL_VTIMER_Context.maxCalibrationInterval : interval*2;
+  }
+  if (interval != HAL_VTIMER_Context.PeriodicCalibrationInterval) {
+    HAL_VTIMER_Context.PeriodicCalibrationInterval = interval;
+    TIMER_SaveCalibrationInterval(interval);
+  }
+}
+
+#if VTIMER_STATS_ENABLE
+static void _stats_record_masked(uint32_t time)
+{
+  vtimerStats.maskedCount++;
+  vtimerStats.totalMaskedTime += time;
+  if (time > vtimerStats.maxMaskedTime) {
+    vtimerStats.maxMaskedTime = time;
+  }
+}
+
+static void _stats_record_callback(VTIMER_HandleType *timerHandle)
+{
+  uint64_t current_time = TIMER_GetCurrentSysTime();
+  uint64_t latency = 0;
+  uint32_t bucket = 0;
+  
+  if (current_time > timerHandle->expiryTime) {
+    latency = current_time - timerHandle->expiryTime;
+  }
+  if (latency > vtimerStats.maxLatency) {
+    vtimerStats.maxLatency = (latency > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)latency;
+  }
+  /* Index of the most significant bit set, plus one */
+  while ((latency != 0) && (bucket < (VTIMER_STATS_LATENCY_BUCKETS - 1))) {
+    latency >>= 1;
+    bucket++;
+  }
+  vtimerStats.latencyHistogram[bucket]++;
+  vtimerStats.callbackCount++;
+}
+
+static void _stats_record_queue_depth(void)
+{
+  uint32_t depth = HAL_VTIMER_GetPendingTimers();
+  
+  if (depth > vtimerStats.maxQueueDepth) {
+    vtimerStats.maxQueueDepth = depth;
+  }
+}
+#endif
+
+/* Latest wakeup time that still serves first and every active timer expiring before it
+   within its slack. All these timers are then served by a single wakeup. */
+static uint64_t _coalesced_expiry_time(VTIMER_HandleType *first)
+{
+  uint64_t limit = first->expiryTime + first->slack;
+  VTIMER_HandleType *curr = _next_timer_in_window(first, limit);
+  
+  while (curr != NULL) {
+    if (curr->active && ((curr->expiryTime + curr->slack) < limit)) {
+      limit = curr->expiryTime + curr->slack;
+    }
+    curr = _next_timer_in_window(curr, limit);
+  }
+  
+  return limit;
+}
+
 /* Set timeout and skip non active timers */
 static VTIMER_HandleType *_update_user_timeout(VTIMER_HandleType *rootNode, uint8_t *expired)
 {
   VTIMER_HandleType *curr = rootNode;
   VTIMER_HandleType *rootOrig = rootNode;
+  uint64_t expiryTime;
   int64_t delay;
   *expired =0;
   while (curr != NULL) {
     if (curr->active) {
       ATOMIC_SECTION_BEGIN();
+      STATS_MASKED_BEGIN();
 #if HOST_WAKEUP_FIX_ENABLE
       uint8_t dummy;
       BOOL share = FALSE;
       _check_radio_activity(&radioTimer,&dummy);
 #endif
-      delay = curr->expiryTime-TIMER_GetCurrentSysTime();
+      expiryTime = _coalesced_expiry_time(curr);
+      delay = expiryTime-TIMER_GetCurrentSysTime();
       if (delay > 0) {
+        HAL_VTIMER_Context.wakeupTime = expiryTime;
         /* Protection against interrupt must be used to avoid that the called function will be interrupted
           and so the timer programming will happen after the target time is already passed
           leading to a timer expiring after timer wraps, instead of the expected delay */
 #if HOST_WAKEUP_FIX_ENABLE
         /* Is the active radio operation before or too close the host timeout? */
-        if(((radioTimer.expiryTime) < (curr->expiryTime + hostMargin)) && radioTimer.active)
+        if(((radioTimer.expiryTime) < (expiryTime + hostMargin)) && radioTimer.active)
         {
-          if((radioTimer.expiryTime >= curr->expiryTime) && radioTimer.active)
+          if((radioTimer.expiryTime >= expiryTime) && radioTimer.active)
           {
             hostIsRadioPending = 1;
           }
@@ -320,22 +599,62 @@ static VTIMER_HandleType *_update_user_timeout(VTIMER_HandleType *rootNode, uint
 #else
         TIMER_SetWakeupTime(delay, TRUE);
 #endif
+        STATS_MASKED_END();
         ATOMIC_SECTION_END();
         break;
       }
       else {
         *expired = 1;
+        HAL_VTIMER_Context.wakeupTime = 0;
+        STATS_MASKED_END();
         ATOMIC_SECTION_END();
         break;
       }
     }
+#if VTIMER_HEAP_ENABLE
+    /* Drop the non active root: the heap root has no sibling to skip to */
+    curr = _remove_timer_in_queue(curr, curr);
+    rootOrig = curr;
+#else
     curr=curr->next;
+#endif
   }
   if (*expired)
     return rootOrig;
   return curr;
 }
 
+#if VTIMER_HEAP_ENABLE
+/* Pop the expired timers from the heap and return them as a list ordered by expiry time */
+static VTIMER_HandleType *_check_callbacks(VTIMER_HandleType *rootNode,VTIMER_HandleType **expiredList)
+{
+  VTIMER_HandleType *curr;
+  VTIMER_HandleType *last = NULL;
+  uint64_t current_time = TIMER_GetCurrentSysTime();
+  int64_t delay;
+  
+  *expiredList = NULL;
+  
+  while (rootNode != NULL) {
+    delay = rootNode->expiryTime-current_time;
+    if (delay > 5) { /*TBR*/
+      /* End of expired timers */
+      break;
+    }
+    curr = rootNode;
+    rootNode = _remove_timer_in_queue(rootNode, curr);
+    if (last == NULL) {
+      *expiredList = curr;
+    }
+    else {
+      last->next = curr;
+    }
+    last = curr;
+  }
+  
+  return rootNode;
+}
+#else
 /* Check the number of expired timer from rootNode (ordered list of timers) and return the list of expired timers */
 static VTIMER_HandleType *_check_callbacks(VTIMER_HandleType *rootNode,VTIMER_HandleType **expiredList)
 {
@@ -345,13 +664,15 @@ static VTIMER_HandleType *_check_callbacks(VTIMER_HandleType *rootNode,VTIMER_Ha
   VTIMER_HandleType *returnValue = rootNode;
   *expiredList = rootNode;
   
+  /* Timers expiring while the list is walked are caught by the next _update_user_timeout */
+  uint64_t current_time = TIMER_GetCurrentSysTime();
   int64_t delay;
   uint32_t expiredCount = 0;
   
   while (curr != NULL) {
     
     if (curr->active) {
-      delay = curr->expiryTime-TIMER_GetCurrentSysTime();
+      delay = curr->expiryTime-current_time;
       
       if (delay > 5) { /*TBR*/
         /* End of expired timers list*/
@@ -376,6 +697,7 @@ static VTIMER_HandleType *_check_callbacks(VTIMER_HandleType *rootNode,VTIMER_Ha
   
   return returnValue;
 }
+#endif /* VTIMER_HEAP_ENABLE */
 
 #if HOST_WAKEUP_FIX_ENABLE
 static void _check_host_activity(void)
@@ -389,8 +711,9 @@ static void _check_host_activity(void)
 }
 #endif
 
-static int _start_timer(VTIMER_HandleType *timerHandle, uint64_t time)
+static int _start_timer(VTIMER_HandleType *timerHandle, uint64_t time, uint32_t slack, uint32_t period)
 {
+  VTIMER_HandleType *rootNode;
   uint8_t expired = 0;
 
   /* The timer is already started*/
@@ -399,18 +722,40 @@ static int _start_timer(VTIMER_HandleType *timerHandle, uint64_t time)
     return 1;
   }
   timerHandle->expiryTime = time;
+  timerHandle->slack = slack;
+  timerHandle->period = period;
   timerHandle->active = TRUE;
-  if (_insert_timer_in_queue(HAL_VTIMER_Context.rootNode, timerHandle) == timerHandle) {
-    HAL_VTIMER_Context.rootNode = _update_user_timeout(timerHandle, &expired);
+  rootNode = _insert_timer_in_queue(HAL_VTIMER_Context.rootNode, timerHandle);
+  /* The wakeup is also moved earlier by a timer inserted behind the root, when it
+     expires before the coalesced wakeup time of the root */
+  if ((rootNode == timerHandle) || ((timerHandle->expiryTime + timerHandle->slack) < HAL_VTIMER_Context.wakeupTime)) {
+    HAL_VTIMER_Context.rootNode = _update_user_timeout(rootNode, &expired);
     if (expired) {
       /* A new root timer is already expired, mimic timer expire that is normally signaled
        through the interrupt handler that increase the number of expired timers*/
       INCREMENT_EXPIRE_COUNT;
     }
   }
+  STATS_RECORD_QUEUE_DEPTH();
   return expired;
 }
 
+/* Re-arm an expired periodic timer one period after its previous expiry time, so that the
+   callback latency does not accumulate. If the next expiry time is already in the past,
+   the missed periods are skipped and the timer keeps its original phase.
+   The time sampled by _check_callbacks is enough: a timer re-armed in the past expires
+   at once and it is served by the next pass of the tick. */
+static void _restart_periodic_timer(VTIMER_HandleType *timerHandle)
+{
+  uint64_t expiryTime = timerHandle->expiryTime + timerHandle->period;
+  uint64_t current_time = TIMER_GetSysTimeSnapshot();
+  
+  if (expiryTime <= current_time) {
+    expiryTime += ((current_time - expiryTime)/timerHandle->period + 1)*timerHandle->period;
+  }
+  _start_timer(timerHandle, expiryTime, timerHandle->slack, timerHandle->period);
+}
+
 static void _virtualTimeBaseEnable(FunctionalState state)
 {
   if(state != DISABLE)
@@ -544,16 +889,20 @@ void HAL_VTIMER_WakeUpCallback(void)
  */
 void HAL_VTIMER_TimeoutCallback(void)
 {
+#if !TIMER_SIM_ENABLE
   volatile uint32_t status;
+#endif
 #if HOST_WAKEUP_FIX_ENABLE
   hostIsRadioPending = 0;
 #endif
   /* Disable host timer */
   TIMER_DISABLE_CM0_TIMER;
   INCREMENT_EXPIRE_COUNT_ISR;
+#if !TIMER_SIM_ENABLE
   /* Clear the interrupt */
   WAKEUP->WAKEUP_CM0_IRQ_STATUS |= 1;
   status = WAKEUP->WAKEUP_CM0_IRQ_STATUS;
+#endif
 }
 
 /**
@@ -590,7 +939,7 @@ void HAL_VTIMER_RadioTimerIsr(void)
 int HAL_VTIMER_StartTimerSysTime(VTIMER_HandleType *timerHandle, uint64_t time)
 {
   uint8_t retVal;
-  retVal = _start_timer(timerHandle, time);
+  retVal = _start_timer(timerHandle, time, 0, 0);
   _virtualTimeBaseEnable(ENABLE);
   return retVal;
 }
@@ -606,7 +955,52 @@ int HAL_VTIMER_StartTimerMs(VTIMER_HandleType *timerHandle, uint32_t msRelTimeou
 {
   uint64_t temp = msRelTimeout;
   uint8_t retVal;
-  retVal = _start_timer(timerHandle, TIMER_GetCurrentSysTime() + (temp*TIMER_SYSTICK_PER_10MS)/10);
+  retVal = _start_timer(timerHandle, TIMER_GetCurrentSysTime() + (temp*TIMER_SYSTICK_PER_10MS)/10, 0, 0);
+  _virtualTimeBaseEnable(ENABLE);
+  return retVal;
+}
+
+/**
+ * @brief  Starts a one-shot virtual timer for the given relative timeout value expressed in ms,
+ *         allowing its expiration to be delayed by up to msSlack ms so that it can share
+ *         the wakeup of another timer.
+ * @param  timerHandle: The virtual timer
+ * @param  msRelTimeout: The relative time, from current time, expressed in ms
+ * @param  msSlack: The maximum delay accepted on the timeout, expressed in ms
+ * @retval 0 if the timerHandle is valid.
+ * @retval 1 if the timerHandle is not valid. It is already started.
+ */
+int HAL_VTIMER_StartTimerMsWithSlack(VTIMER_HandleType *timerHandle, uint32_t msRelTimeout, uint32_t msSlack)
+{
+  uint64_t temp = msRelTimeout;
+  uint64_t slack = msSlack;
+  uint8_t retVal;
+  retVal = _start_timer(timerHandle, TIMER_GetCurrentSysTime() + (temp*TIMER_SYSTICK_PER_10MS)/10, (uint32_t)((slack*TIMER_SYSTICK_PER_10MS)/10), 0);
+  _virtualTimeBaseEnable(ENABLE);
+  return retVal;
+}
+
+/**
+ * @brief  Starts a periodic virtual timer expiring every msPeriod ms, the first time msPeriod ms
+ *         from current time. Each expiry time is computed from the previous one, so that the
+ *         callback latency does not cause any drift. The timer runs until it is stopped or
+ *         started again as a one-shot timer.
+ * @param  timerHandle: The virtual timer
+ * @param  msPeriod: The period expressed in ms, rounded to the nearest STU. It must not be 0.
+ * @retval 0 if the timerHandle is valid.
+ * @retval 1 if the timerHandle is not valid. It is already started.
+ * @retval 2 if msPeriod is 0. The timer is not started.
+ */
+int HAL_VTIMER_StartTimerPeriodicMs(VTIMER_HandleType *timerHandle, uint32_t msPeriod)
+{
+  uint64_t temp = msPeriod;
+  uint32_t period = (uint32_t)((temp*TIMER_SYSTICK_PER_10MS + 5)/10);
+  uint8_t retVal;
+  /* A null period would re-arm the timer at the same expiry time forever */
+  if (msPeriod == 0U) {
+    return 2;
+  }
+  retVal = _start_timer(timerHandle, TIMER_GetCurrentSysTime() + period, 0, period);
   _virtualTimeBaseEnable(ENABLE);
   return retVal;
 }
@@ -684,8 +1078,14 @@ uint64_t HAL_VTIMER_GetAnchorPoint(void)
  */
 void HAL_VTIMER_StopTimer(VTIMER_HandleType *timerHandle)
 {
-  VTIMER_HandleType *rootNode = _remove_timer_in_queue(HAL_VTIMER_Context.rootNode, timerHandle);
+  VTIMER_HandleType *rootNode;
   uint8_t expired = 0;
+  timerHandle->period = 0;
+  /* A timer never started, expired or already stopped is not in the queue */
+  if (timerHandle->active == FALSE) {
+    return;
+  }
+  rootNode = _remove_timer_in_queue(HAL_VTIMER_Context.rootNode, timerHandle);
   timerHandle->active=FALSE;
   if (HAL_VTIMER_Context.rootNode != rootNode) {
     HAL_VTIMER_Context.rootNode = _update_user_timeout(rootNode, &expired);
@@ -709,6 +1109,17 @@ uint64_t HAL_VTIMER_GetCurrentSysTime(void)
   return TIMER_GetCurrentSysTime();
 }
 
+/**
+ * @brief  This function returns the system time sampled by the timer module without reading
+ *         the hardware timer. It is refreshed at least once per HAL_VTIMER_Tick() call, so it
+ *         is behind the current time by at most the time elapsed since the last tick.
+ * @return system time snapshot expressed in system time units.
+ */
+uint64_t HAL_VTIMER_GetSysTimeSnapshot(void)
+{
+  return TIMER_GetSysTimeSnapshot();
+}
+
 /**
  * @brief  This function returns the sum of an absolute time and a signed relative time.
  * @param  sysTime: Absolute time expressed in internal time units.
@@ -750,6 +1161,9 @@ int HAL_VTIMER_ExpiryTime(VTIMER_HandleType *timerHandle, uint64_t *sysTime)
  */
 uint32_t HAL_VTIMER_GetPendingTimers(void)
 {
+#if VTIMER_HEAP_ENABLE
+  return heapCount;
+#else
   VTIMER_HandleType *curr = HAL_VTIMER_Context.rootNode;
   uint32_t counter = 0;
   while (curr != NULL) {
@@ -757,8 +1171,104 @@ uint32_t HAL_VTIMER_GetPendingTimers(void)
     curr = curr->next;
   }
   return counter;
+#endif
+}
+
+/**
+ * @brief  Returns the number of wakeups saved by delaying timers within their slack.
+ * @return number of coalesced wakeups.
+ */
+uint32_t HAL_VTIMER_GetCoalescedWakeups(void)
+{
+  return HAL_VTIMER_Context.coalescedWakeups;
+}
+
+/**
+ * @brief  Let the periodic calibration interval follow the low speed clock drift.
+ *         After each calibration the interval is doubled if the drift since the previous
+ *         calibration is below a quarter of DriftThreshold and halved if it is above DriftThreshold,
+ *         within MinInterval and MaxInterval. The forced calibration during the active phase
+ *         also follows the adaptive interval instead of occurring every 5 seconds.
+ * @param  config: Adaptive policy, NULL to restore the fixed interval set by HAL_VTIMER_Init()
+ * @retval 0 if the policy has been applied.
+ * @retval 1 if the periodic calibration is disabled or the bounds are not valid.
+ */
+uint8_t HAL_VTIMER_SetAdaptiveCalibration(HAL_VTIMER_AdaptiveCalibrationType *config)
+{
+  uint32_t maxInterval = TIMER_MachineTimeToSysTime(TIMER_MAX_VALUE-TIMER_WRAPPING_MARGIN);
+  uint32_t minInterval;
+  
+  if (config == NULL) {
+    HAL_VTIMER_Context.adaptiveCalibration = FALSE;
+    HAL_VTIMER_Context.PeriodicCalibrationInterval = HAL_VTIMER_Context.initialCalibrationInterval;
+    TIMER_SaveCalibrationInterval(HAL_VTIMER_Context.PeriodicCalibrationInterval);
+    return 0;
+  }
+  
+  if ((calibrationData.periodic_calibration == FALSE) || (config->MinInterval == 0) || \
+      (config->MinInterval > config->MaxInterval)) {
+    return 1;
+  }
+  
+  minInterval = MIN(((uint64_t)TIMER_SYSTICK_PER_10MS * config->MinInterval)/10, maxInterval);
+  maxInterval = MIN(((uint64_t)TIMER_SYSTICK_PER_10MS * config->MaxInterval)/10, maxInterval);
+  HAL_VTIMER_Context.minCalibrationInterval = minInterval;
+  HAL_VTIMER_Context.maxCalibrationInterval = maxInterval;
+  HAL_VTIMER_Context.driftThreshold = config->DriftThreshold;
+  /* The new bounds apply from the next calibration event */
+  HAL_VTIMER_Context.PeriodicCalibrationInterval = MIN(MAX(HAL_VTIMER_Context.PeriodicCalibrationInterval, minInterval), maxInterval);
+  TIMER_SaveCalibrationInterval(HAL_VTIMER_Context.PeriodicCalibrationInterval);
+  HAL_VTIMER_Context.adaptiveCalibration = TRUE;
+  
+  return 0;
+}
+
+/**
+ * @brief  Return the achieved calibration interval and the measured drift.
+ * @param  stats: Pointer to the structure filled with the calibration statistics
+ * @retval None
+ */
+void HAL_VTIMER_GetCalibrationStats(HAL_VTIMER_CalibrationStatsType *stats)
+{
+  stats->Interval = (uint32_t)(((uint64_t)HAL_VTIMER_Context.PeriodicCalibrationInterval*10)/TIMER_SYSTICK_PER_10MS);
+  stats->LastDrift = HAL_VTIMER_Context.lastDrift;
+  stats->MaxDrift = HAL_VTIMER_Context.maxDrift;
+  stats->LastError = HAL_VTIMER_Context.lastDriftError;
+  stats->CalibrationCount = HAL_VTIMER_Context.calibrationCount;
 }
 
+#if VTIMER_STATS_ENABLE
+/**
+ * @brief  Copy the callback dispatch statistics collected since the initialization
+ *         or the last HAL_VTIMER_ResetStats().
+ * @param  stats: Pointer to the structure filled with the statistics
+ * @retval None
+ */
+void HAL_VTIMER_GetStats(HAL_VTIMER_StatsType *stats)
+{
+  *stats = vtimerStats;
+}
+
+/**
+ * @brief  Clear the callback dispatch statistics.
+ * @retval None
+ */
+void HAL_VTIMER_ResetStats(void)
+{
+  uint32_t i;
+  
+  for (i = 0; i < VTIMER_STATS_LATENCY_BUCKETS; i++) {
+    vtimerStats.latencyHistogram[i] = 0;
+  }
+  vtimerStats.callbackCount = 0;
+  vtimerStats.maxLatency = 0;
+  vtimerStats.maxQueueDepth = 0;
+  vtimerStats.maskedCount = 0;
+  vtimerStats.maxMaskedTime = 0;
+  vtimerStats.totalMaskedTime = 0;
+}
+#endif
+
 /**
  * @brief  Initialize the timer module. It must be placed in the initialization
  *         section of the application.
@@ -775,7 +1285,9 @@ void HAL_VTIMER_Init(HAL_VTIMER_InitType *HAL_TIMER_InitStruct)
     hostMargin = MAX(HOST_MARGIN,HAL_TIMER_InitStruct->XTAL_StartupTime);
 #endif
   
+#if !TIMER_SIM_ENABLE
   NVIC_EnableIRQ(BLE_ERROR_IRQn);
+#endif
 
   TIMER_InitStruct.TIMER_InitialCalibration = HAL_TIMER_InitStruct->EnableInitialCalibration;
   TIMER_InitStruct.TIMER_PeriodicCalibration = (HAL_TIMER_InitStruct->PeriodicCalibrationInterval!=0);
@@ -783,6 +1295,9 @@ void HAL_VTIMER_Init(HAL_VTIMER_InitType *HAL_TIMER_InitStruct)
   TIMER_Init(&TIMER_InitStruct);
   TIMER_GetCurrentCalibrationData(&calibrationData); 
   HAL_VTIMER_Context.rootNode = NULL;
+#if VTIMER_HEAP_ENABLE
+  heapCount = 0;
+#endif
   HAL_VTIMER_Context.enableTimeBase = TRUE;
   HAL_VTIMER_Context.wakeup_calibration = (HAL_TIMER_InitStruct->PeriodicCalibrationInterval!=0);
   HAL_VTIMER_Context.stop_notimer_action = FALSE;
@@ -793,6 +1308,9 @@ void HAL_VTIMER_Init(HAL_VTIMER_InitType *HAL_TIMER_InitStruct)
   HAL_VTIMER_Context.hs_startup_time = HAL_TIMER_InitStruct->XTAL_StartupTime;
   HAL_VTIMER_Context.expired_count=0;
   HAL_VTIMER_Context.served_count=0;
+  HAL_VTIMER_Context.coalescedWakeups = 0;
+  HAL_VTIMER_Context.wakeupTime = 0;
+  HAL_VTIMER_ResetStats();
   HAL_VTIMER_Context.PeriodicCalibrationInterval = (TIMER_SYSTICK_PER_10MS * HAL_TIMER_InitStruct->PeriodicCalibrationInterval)/10;
   HAL_VTIMER_Context.calibration_in_progress = FALSE;
   if (HAL_VTIMER_Context.PeriodicCalibrationInterval == 0)
@@ -800,9 +1318,15 @@ void HAL_VTIMER_Init(HAL_VTIMER_InitType *HAL_TIMER_InitStruct)
   else
     HAL_VTIMER_Context.PeriodicCalibrationInterval = MIN(HAL_VTIMER_Context.PeriodicCalibrationInterval,
                                                        TIMER_MachineTimeToSysTime(TIMER_MAX_VALUE-TIMER_WRAPPING_MARGIN));
+  HAL_VTIMER_Context.initialCalibrationInterval = HAL_VTIMER_Context.PeriodicCalibrationInterval;
+  HAL_VTIMER_Context.adaptiveCalibration = FALSE;
+  HAL_VTIMER_Context.lastDrift = 0;
+  HAL_VTIMER_Context.maxDrift = 0;
+  HAL_VTIMER_Context.lastDriftError = 0;
+  HAL_VTIMER_Context.calibrationCount = 0;
   calibrationTimer.callback = calibration_callback;
   calibrationTimer.userData = NULL;
-  _start_timer(&calibrationTimer, TIMER_GetCurrentSysTime() + HAL_VTIMER_Context.PeriodicCalibrationInterval);
+  _start_timer(&calibrationTimer, TIMER_GetCurrentSysTime() + HAL_VTIMER_Context.PeriodicCalibrationInterval, 0, 0);
   TIMER_SaveCalibrationInterval(HAL_VTIMER_Context.PeriodicCalibrationInterval);  
 }
 
@@ -817,8 +1341,10 @@ void HAL_VTIMER_Tick(void)
   uint8_t expired = 0;
 
   ATOMIC_SECTION_BEGIN();
+  /* Also refreshes the time snapshot at each tick */
+  uint64_t current_time = TIMER_GetCurrentSysTime();
   if(radioTimer.active){
-    if(radioTimer.expiryTime < TIMER_GetCurrentSysTime()){
+    if(radioTimer.expiryTime < current_time){
       radioTimer.active = FALSE;
     }
   }
@@ -827,19 +1353,36 @@ void HAL_VTIMER_Tick(void)
   /* Check for expired timers */  
   while (DIFF8(HAL_VTIMER_Context.expired_count,HAL_VTIMER_Context.served_count)) {
     VTIMER_HandleType *expiredList, *curr;
+    uint64_t wakeupTime = HAL_VTIMER_Context.wakeupTime;
+    uint64_t lastExpiryTime = 0;
     uint8_t to_be_served = DIFF8(HAL_VTIMER_Context.expired_count,HAL_VTIMER_Context.served_count);
     
     HAL_VTIMER_Context.rootNode = _check_callbacks(HAL_VTIMER_Context.rootNode, &expiredList);
     
     /* Call all the user callbacks */
     curr=expiredList;
+    if (curr != NULL) {
+      lastExpiryTime = curr->expiryTime;
+    }
     while (curr != NULL) {
 
       /* Save next pointer, in case callback start the timer again */
       VTIMER_HandleType *next = curr->next;
+      /* A timer needing its own wakeup without slack (see _check_callbacks), but served
+         by the programmed wakeup, has been merged thanks to the slack. The timers
+         only served together because the tick is late are not counted. */
+      if ((curr->expiryTime > lastExpiryTime + 5) && (curr->expiryTime <= wakeupTime)) {
+        HAL_VTIMER_Context.coalescedWakeups++;
+        lastExpiryTime = curr->expiryTime;
+      }
       curr->active = FALSE;
+      STATS_RECORD_CALLBACK(curr);
       if (curr->callback)
         curr->callback(curr); /* we are sure a callback is set?*/
+      /* Re-arm periodic timers not stopped or restarted by their callback */
+      if ((curr->period != 0) && (curr->active == FALSE)) {
+        _restart_periodic_timer(curr);
+      }
       curr = next;
     }
     
@@ -859,9 +1402,13 @@ void HAL_VTIMER_Tick(void)
       if ((HAL_VTIMER_Context.wakeup_calibration == FALSE) && HAL_VTIMER_Context.stop_notimer_action) {
         HAL_VTIMER_Context.stop_notimer_action = FALSE;
       } else {
+        TIMER_CalibrationType previousData = calibrationData;
         /* Collect calibration data */
         TIMER_UpdateCalibrationData();
         TIMER_GetCurrentCalibrationData(&calibrationData);
+        if (calibrationData.periodic_calibration) {
+          _update_calibration_interval(&previousData);
+        }
       }
 #if HOST_WAKEUP_FIX_ENABLE
       if(waitCal){
@@ -875,13 +1422,14 @@ void HAL_VTIMER_Tick(void)
 #endif
       HAL_VTIMER_StopTimer(&calibrationTimer);
       /* Schedule next calibration event */
-      _start_timer(&calibrationTimer, TIMER_GetCurrentSysTime() + HAL_VTIMER_Context.PeriodicCalibrationInterval);
+      _start_timer(&calibrationTimer, TIMER_GetCurrentSysTime() + HAL_VTIMER_Context.PeriodicCalibrationInterval, 0, 0);
     }		
   }
   /* if there is a periodic calibration, start it in advance during the active phase */
   else{
     if(calibrationData.periodic_calibration){
-      if( TIMER_GetCurrentSysTime() > (calibrationData.last_calibration_time + TIMER_SYSTICK_PER_FIVE_SECONDS))
+      uint32_t activeInterval = HAL_VTIMER_Context.adaptiveCalibration ? HAL_VTIMER_Context.PeriodicCalibrationInterval : ACTIVE_CALIB_INTERVAL;
+      if( TIMER_GetSysTimeSnapshot() > (calibrationData.last_calibration_time + activeInterval))
       {
         calibration_callback(&calibrationTimer);
       }
@@ -930,14 +1478,15 @@ PowerSaveLevels HAL_VTIMER_PowerSaveLevelCheck(PowerSaveLevels level)
 
   if(HAL_VTIMER_Context.rootNode != NULL && HAL_VTIMER_Context.rootNode->active)
   {
-    if(HAL_VTIMER_Context.rootNode->expiryTime < (current_time + LOW_POWER_THR + HAL_VTIMER_Context.hs_startup_time))
+    /* The wakeup programmed for the root may be delayed within the slack of the timers */
+    if(HAL_VTIMER_Context.wakeupTime < (current_time + LOW_POWER_THR + HAL_VTIMER_Context.hs_startup_time))
     {
       return POWER_SAVE_LEVEL_CPU_HALT;
     }
     
     if(level == POWER_SAVE_LEVEL_STOP_NOTIMER)
     {
-      if((HAL_VTIMER_Context.rootNode->next == NULL) && (HAL_VTIMER_Context.rootNode == &calibrationTimer))
+      if(QUEUE_HAS_SINGLE_TIMER(HAL_VTIMER_Context.rootNode) && (HAL_VTIMER_Context.rootNode == &calibrationTimer))
       {
         HAL_VTIMER_Context.stop_notimer_action = TRUE;
         _virtualTimeBaseEnable(DISABLE);
@@ -30,6 +30,10 @@
 
 #define RSSI_OFFSET 119
 
+/* The RSSI filter tables cover differences between the sample and the average from -32 dB to +32 dB */
+#define RSSI_FILTER_RANGE         (32 * 64)
+#define RSSI_FILTER_TABLE_SIZE    (65)
+
 /** @addtogroup RF_DRIVER_LL_Driver
   * @{
   */
@@ -118,6 +122,53 @@
 
 RadioGlobalParameters_t globalParameters;
 
+/* Number of bits of a 4-bit value */
+static const uint8_t rssiBitLength[16] = {0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+
+/* (417 * x + 18080) >> 10 for x from 0 to 30: contribution of the RSSI mantissa in dB */
+static const uint8_t rssiMantissaDb[31] = {
+  17, 18, 18, 18, 19, 19, 20, 20, 20, 21, 21, 22, 22, 22, 23, 23,
+  24, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 28, 29, 29, 29
+};
+
+/* Change of the average RSSI, in 1/64 dB, when a sample d dB away from the average is added
+   with a weight a to the received power: 10 * log10(1 - a + a * 10^(d / 10)), for d from -32 to +32.
+   Below -32 dB the sample is negligible, above +32 dB the change increases as d. */
+static const int16_t rssiFilterTable[RSSI_FILTER_MAX_COEFF][RSSI_FILTER_TABLE_SIZE] = {
+  /* Weight 1/2 */
+  {
+     -192,  -192,  -192,  -192,  -192,  -192,  -192,  -192,  -192,  -191,  -191,  -190,  -190,
+     -189,  -188,  -187,  -186,  -184,  -182,  -179,  -176,  -171,  -166,  -160,  -152,  -142,
+     -130,  -116,  -100,   -80,   -57,   -30,     0,    34,    71,   112,   156,   204,   254,
+      306,   360,   416,   474,   533,   592,   653,   714,   776,   838,   901,   964,  1027,
+     1090,  1154,  1217,  1281,  1344,  1408,  1472,  1536,  1600,  1664,  1728,  1792,  1856
+  },
+  /* Weight 1/4 */
+  {
+      -80,   -80,   -80,   -80,   -80,   -80,   -80,   -80,   -80,   -79,   -79,   -79,   -79,
+      -79,   -78,   -78,   -78,   -77,   -76,   -75,   -74,   -73,   -71,   -69,   -66,   -62,
+      -58,   -52,   -45,   -37,   -27,   -15,     0,    17,    38,    62,    89,   120,   155,
+      193,   235,   280,   328,   378,   431,   486,   542,   600,   659,   719,   780,   841,
+      903,   965,  1028,  1091,  1154,  1217,  1281,  1344,  1408,  1472,  1536,  1599,  1663
+  },
+  /* Weight 1/8 */
+  {
+      -37,   -37,   -37,   -37,   -37,   -37,   -37,   -37,   -37,   -37,   -37,   -37,   -37,
+      -37,   -36,   -36,   -36,   -36,   -36,   -35,   -35,   -34,   -33,   -32,   -31,   -29,
+      -27,   -25,   -22,   -18,   -13,    -7,     0,     9,    20,    33,    48,    66,    88,
+      113,   141,   174,   210,   249,   292,   338,   386,   438,   491,   546,   603,   661,
+      721,   781,   842,   904,   966,  1028,  1091,  1154,  1217,  1280,  1344,  1408,  1471
+  },
+  /* Weight 1/16 */
+  {
+      -18,   -18,   -18,   -18,   -18,   -18,   -18,   -18,   -18,   -18,   -18,   -18,   -18,
+      -18,   -18,   -18,   -17,   -17,   -17,   -17,   -17,   -16,   -16,   -16,   -15,   -14,
+      -13,   -12,   -11,    -9,    -6,    -4,     0,     4,    10,    17,    25,    35,    47,
+       62,    80,   100,   124,   151,   182,   217,   256,   297,   342,   390,   441,   493,
+      548,   605,   662,   722,   781,   842,   904,   966,  1028,  1091,  1154,  1217,  1280
+  }
+};
+
 /**
   * @}
   */ 
@@ -138,6 +189,7 @@ int8_t RADIO_ReadRSSI(void)
  
   uint32_t rssi_int16 = ((rssi1&0xFF)<<8)|(rssi0&0xFF);
   uint32_t reg_agc = RRM->AGC_DIG_OUT;
+  uint32_t shift = 0U, msb;
    
   if ((rssi_int16 == 0U) || (reg_agc > 0xbU))
   {
@@ -145,17 +197,119 @@ int8_t RADIO_ReadRSSI(void)
   }
   else
   {
-    rssi_dbm = (int32_t)reg_agc * 6 - RSSI_OFFSET;//127 ;
-    while (rssi_int16 > 30U)
+    /* The value is halved until it is not above 30, each halving is worth 6 dB.
+       The number of halvings is derived from the position of the most significant bit. */
+    if (rssi_int16 > 30U)
     {
-      rssi_dbm = rssi_dbm + 6 ;
-      rssi_int16 = (rssi_int16 >> 1) ;
+      msb = rssi_int16;
+      if (msb > 0xFFU)
+      {
+        shift = 8U;
+        msb = msb >> 8;
+      }
+      if (msb > 0xFU)
+      {
+        shift += 4U;
+        msb = msb >> 4;
+      }
+      shift = shift + rssiBitLength[msb] - 5U;
+      if ((rssi_int16 >> shift) > 30U)
+      {
+        shift++;
+      }
     }
-    rssi_dbm = rssi_dbm + (int32_t)(uint32_t)((417U*rssi_int16 + 18080U)>>10) ;
+    rssi_dbm = (int32_t)(reg_agc + shift) * 6 - RSSI_OFFSET + (int32_t)rssiMantissaDb[rssi_int16 >> shift];
   }
   return (int8_t)rssi_dbm;
 }
 
+/**
+ * @brief  Initialize an RSSI filter.
+ *         The filter is an exponential average of the received power, not of the RSSI in dBm:
+ *         a few strong packets raise the average more than the same number of weak packets lower it.
+ * @param  filter: RSSI filter.
+ * @param  attack_coeff: the weight of a sample above the average is 2^-attack_coeff.
+ *         From 0 (no filtering) to RSSI_FILTER_MAX_COEFF.
+ * @param  decay_coeff: the weight of a sample below the average is 2^-decay_coeff.
+ *         From 0 (no filtering) to RSSI_FILTER_MAX_COEFF.
+ * @retval None
+ */
+void RADIO_RSSIFilterInit(RSSIFilter_t *filter, uint8_t attack_coeff, uint8_t decay_coeff)
+{
+  assert_param(attack_coeff <= RSSI_FILTER_MAX_COEFF);
+  assert_param(decay_coeff <= RSSI_FILTER_MAX_COEFF);
+  
+  filter->Average = 0;
+  filter->AttackCoeff = attack_coeff;
+  filter->DecayCoeff = decay_coeff;
+  filter->Valid = FALSE;
+}
+
+/**
+ * @brief  Add a sample to an RSSI filter.
+ *         The computation uses a table lookup and an interpolation, it can be done in the data routine
+ *         of an action packet.
+ * @param  filter: RSSI filter.
+ * @param  rssi: RSSI in dBm, as returned by RADIO_ReadRSSI(). The invalid value 127 is ignored.
+ * @retval int8_t: average RSSI in dBm, 127 if no valid sample has been added.
+ */
+int8_t RADIO_RSSIFilterUpdate(RSSIFilter_t *filter, int8_t rssi)
+{
+  const int16_t *table;
+  int32_t diff, correction;
+  uint32_t coeff, index, frac;
+  
+  if (rssi == 127)
+  {
+    return RADIO_RSSIFilterGet(filter);
+  }
+  
+  diff = (int32_t)rssi * 64 - filter->Average;
+  coeff = (diff > 0) ? filter->AttackCoeff : filter->DecayCoeff;
+  
+  if ((filter->Valid == FALSE) || (coeff == 0U))
+  {
+    filter->Average = (int16_t)((int32_t)rssi * 64);
+    filter->Valid = TRUE;
+  }
+  else
+  {
+    table = rssiFilterTable[coeff - 1U];
+    if (diff <= -RSSI_FILTER_RANGE)
+    {
+      correction = table[0];
+    }
+    else if (diff >= RSSI_FILTER_RANGE)
+    {
+      correction = table[RSSI_FILTER_TABLE_SIZE - 1] + diff - RSSI_FILTER_RANGE;
+    }
+    else
+    {
+      /* Table step of 1 dB, linear interpolation on the 1/64 dB fraction */
+      index = (uint32_t)(diff + RSSI_FILTER_RANGE) >> 6;
+      frac = (uint32_t)(diff + RSSI_FILTER_RANGE) & 63U;
+      correction = table[index] + (((table[index + 1U] - table[index]) * (int32_t)frac) >> 6);
+    }
+    filter->Average = (int16_t)(filter->Average + correction);
+  }
+  
+  return RADIO_RSSIFilterGet(filter);
+}
+
+/**
+ * @brief  Read the average RSSI of an RSSI filter.
+ * @param  filter: RSSI filter.
+ * @retval int8_t: average RSSI in dBm, 127 if no valid sample has been added.
+ */
+int8_t RADIO_RSSIFilterGet(RSSIFilter_t *filter)
+{
+  if (filter->Valid == FALSE)
+  {
+    return 127;
+  }
+  return (int8_t)((filter->Average + 32) >> 6);
+}
+
 /**
   * @}
   */ 
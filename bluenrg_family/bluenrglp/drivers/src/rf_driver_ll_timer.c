@@ -480,6 +480,24 @@ uint64_t TIMER_GetCurrentSysTime(void)
   return get_system_time(&TIMER_Context);
 }
 
+/**
+ * @brief   Return the system time sampled by the last call to a function reading the current time,
+ *          such as TIMER_GetCurrentSysTime(), without accessing the hardware timer.
+ *          The returned value is behind the current time by the time elapsed since that call.
+ * @return  System time snapshot in STU
+ */
+uint64_t TIMER_GetSysTimeSnapshot(void)
+{
+  uint64_t snapshot;
+  
+  /* The 64-bit read is not atomic and the snapshot can be updated by an interrupt */
+  ATOMIC_SECTION_BEGIN();
+  snapshot = TIMER_Context.last_system_time;
+  ATOMIC_SECTION_END();
+  
+  return snapshot;
+}
+
 /**
  * @brief   Return the system time referred to the absolute machine time passed as parameter.
  * @param   time: Absolute machine time in the future
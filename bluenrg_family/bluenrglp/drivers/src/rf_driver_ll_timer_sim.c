@@ -0,0 +1,359 @@
+/**
+******************************************************************************
+* @file    rf_driver_ll_timer_sim.c
+* @author  RF Application Team
+* @brief   Simulated radio and sleep timers driven by a virtual clock.
+* @details This file replaces rf_driver_ll_timer.c when CONFIG_BLUENRG_LP_TIMER_SIM is set.
+* It implements the same TIMER API without accessing the WAKEUP, BLUE and RADIO_CTRL
+* peripherals, so that the virtual timer layer (rf_driver_hal_vtimer.c) can run off-target.
+* The time only elapses when TIMER_SIM_Advance() is called. The host timer and the radio
+* timer expiring in the elapsed interval are then triggered at their exact expiry time,
+* by calling the handlers that the interrupt service routines call on target.
+* The simulated low speed oscillator is ideal: the machine time unit is the STU,
+* the calibration completes immediately and it never changes the clock frequency.
+*
+******************************************************************************
+* @attention
+*
+* THE PRESENT FIRMWARE WHICH IS FOR GUIDANCE ONLY AIMS AT PROVIDING CUSTOMERS
+* WITH CODING INFORMATION REGARDING THEIR PRODUCTS IN ORDER FOR THEM TO SAVE
+* TIME. AS A RESULT, STMICROELECTRONICS SHALL NOT BE HELD LIABLE FOR ANY
+* DIRECT, INDIRECT OR CONSEQUENTIAL DAMAGES WITH RESPECT TO ANY CLAIMS ARISING
+* FROM THE CONTENT OF SUCH FIRMWARE AND/OR THE USE MADE BY CUSTOMERS OF THE
+* CODING INFORMATION CONTAINED HEREIN IN CONNECTION WITH THEIR PRODUCTS.
+*
+* <h2><center>&copy; COPYRIGHT 2020 STMicroelectronics</center></h2>
+******************************************************************************
+*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "rf_driver_ll_timer.h"
+#include "rf_driver_hal_vtimer.h"
+
+#if TIMER_SIM_ENABLE
+
+/** @addtogroup RF_DRIVER_LL_Driver
+* @{
+*/
+
+/** @addtogroup TIMER
+  * @{
+  */
+
+/** @defgroup TIMER_SIM_Private_Types TIMER SIM Private Types
+* @{
+*/
+typedef struct timer_sim_context_s {
+  uint64_t current_time; /** Virtual clock, in STU */
+  uint64_t host_time; /** Expiry time of the host timer */
+  uint64_t radio_time; /** Expiry time of the radio timer */
+  uint64_t last_anchor_time; /** Start time of the last radio event programmed */
+  uint64_t last_calibration_time; /** Virtual time of the last calibration */
+  uint32_t calibration_interval; /** Calibration interval in STU */
+  uint8_t host_enabled; /** Host timer programmed */
+  uint8_t radio_enabled; /** Radio timer programmed */
+  uint8_t periodic_calibration;
+  uint8_t calibration_data_available;
+} TIMER_SIM_ContextType;
+
+/**
+* @}
+*/
+
+/** @defgroup TIMER_SIM_Private_Macros TIMER SIM Private Macros
+* @{
+*/
+#define MIN(a,b) ((a) < (b) )? (a) : (b)
+
+/**
+* @}
+*/
+
+/** @defgroup TIMER_SIM_Private_Constants TIMER SIM Private Constants
+* @{
+*/
+
+/* Nominal calibration values of a 32.768 kHz clock, see TIMER_Init() */
+#define SIM_NOMINAL_PERIOD (23437)
+#define SIM_NOMINAL_FREQ   (23456748)
+
+/**
+* @}
+*/
+
+/** @defgroup TIMER_SIM_Private_Variables TIMER SIM Private Variables
+* @{
+*/
+static TIMER_SIM_ContextType TIMER_SIM_Context;
+
+/**
+* @}
+*/
+
+/** @defgroup TIMER_SIM_Private_Functions TIMER SIM Private Functions
+* @{
+*/
+static uint32_t us_to_systime(uint32_t time)
+{
+  uint32_t t1, t2;
+  t1 = time * 0x68;
+  t2 = time * 0xDB;
+  return (t1 >> 8) + (t2 >> 16);
+}
+
+/* Return the 64-bit time closest to the current time whose 32 least significant bits are time */
+static uint64_t sim_time64(uint32_t time)
+{
+  return TIMER_SIM_Context.current_time + (int32_t)(time - (uint32_t)TIMER_SIM_Context.current_time);
+}
+
+static uint8_t sim_set_radio_time(uint64_t time)
+{
+  if (time <= TIMER_SIM_Context.current_time) {
+    TIMER_SIM_Context.radio_enabled = FALSE;
+    return 1;
+  }
+  TIMER_SIM_Context.radio_time = time;
+  TIMER_SIM_Context.radio_enabled = TRUE;
+  TIMER_SIM_Context.last_anchor_time = time;
+  return 0;
+}
+
+/**
+* @}
+*/
+
+/** @defgroup TIMER_Exported_Functions TIMER Exported Functions
+* @{
+*/
+
+void TIMER_Init(TIMER_InitType* TIMER_InitStruct)
+{
+  /* The virtual clock is not reset, so that a test can set it before the initialization */
+  TIMER_SIM_Context.host_enabled = FALSE;
+  TIMER_SIM_Context.radio_enabled = FALSE;
+  TIMER_SIM_Context.last_anchor_time = 0;
+  TIMER_SIM_Context.periodic_calibration = TIMER_InitStruct->TIMER_PeriodicCalibration;
+  TIMER_SIM_Context.calibration_data_available = 0;
+  TIMER_SIM_Context.last_calibration_time = TIMER_SIM_Context.current_time;
+}
+
+void TIMER_Calibrate(void)
+{
+  TIMER_SIM_Context.last_calibration_time = TIMER_SIM_Context.current_time;
+}
+
+void TIMER_StartCalibration(void)
+{
+}
+
+BOOL TIMER_IsCalibrationRunning(void)
+{
+  return FALSE;
+}
+
+BOOL TIMER_IsCalibrationDataAvailable(void)
+{
+  return (TIMER_SIM_Context.calibration_data_available == 1);
+}
+
+void TIMER_ClearCalibrationDataAvailableFlag(void)
+{
+  TIMER_SIM_Context.calibration_data_available = 0;
+}
+
+void TIMER_UpdateCalibrationData(void)
+{
+  if (TIMER_SIM_Context.periodic_calibration) {
+    TIMER_SIM_Context.calibration_data_available = 1;
+  }
+  TIMER_SIM_Context.last_calibration_time = TIMER_SIM_Context.current_time;
+}
+
+uint64_t TIMER_GetCurrentSysTime(void)
+{
+  return TIMER_SIM_Context.current_time;
+}
+
+uint64_t TIMER_GetSysTimeSnapshot(void)
+{
+  /* The virtual clock does not move between two reads */
+  return TIMER_SIM_Context.current_time;
+}
+
+uint64_t TIMER_GetFutureSysTime(uint32_t time)
+{
+  return sim_time64(time);
+}
+
+uint64_t TIMER_GetPastSysTime(uint32_t time)
+{
+  return sim_time64(time);
+}
+
+void TIMER_GetCurrentCalibrationData(TIMER_CalibrationType *data)
+{
+  data->periodic_calibration = TIMER_SIM_Context.periodic_calibration;
+  data->freq = SIM_NOMINAL_FREQ;
+  data->last_calibration_time = TIMER_SIM_Context.last_calibration_time;
+  data->period = SIM_NOMINAL_PERIOD;
+  data->last_calibration_machine_time = (uint32_t)TIMER_SIM_Context.last_calibration_time;
+}
+
+void TIMER_SaveCalibrationInterval(uint32_t time)
+{
+  TIMER_SIM_Context.calibration_interval = time;
+}
+
+void TIMER_ClearRadioTimer2(void)
+{
+  TIMER_SIM_Context.radio_enabled = FALSE;
+}
+
+void TIMER_ClearRadioTimerValue(void)
+{
+  TIMER_SIM_Context.radio_enabled = FALSE;
+}
+
+uint8_t TIMER_GetRadioTimerValue(uint32_t *time)
+{
+  if (TIMER_SIM_Context.radio_enabled) {
+    *time = (uint32_t)TIMER_SIM_Context.radio_time;
+    return WAKEUP_TIMER_BUSY;
+  }
+  return 0;
+}
+
+uint32_t __TIMER_GetSysRfSetupTime(void)
+{
+  /* The simulated radio needs no setup time */
+  return 0;
+}
+
+uint32_t TIMER_SetWakeupTime(uint32_t delay, BOOL allow_sleep)
+{
+  TIMER_SIM_Context.host_time = TIMER_SIM_Context.current_time + delay;
+  TIMER_SIM_Context.host_enabled = TRUE;
+  return (uint32_t)TIMER_SIM_Context.current_time;
+}
+
+uint8_t TIMER_SetRadioTimerValue(uint32_t timeout, BOOL event_type, BOOL cal_req)
+{
+  return sim_set_radio_time(sim_time64(timeout));
+}
+
+uint8_t TIMER_SetRadioTimerRelativeUsValue(uint32_t rel_timeout_us, BOOL event_type, BOOL cal_req)
+{
+  return sim_set_radio_time(TIMER_SIM_Context.last_anchor_time + us_to_systime(rel_timeout_us));
+}
+
+void TIMER_SetRadioCloseTimeout(void)
+{
+  sim_set_radio_time(TIMER_SIM_Context.current_time + 1);
+}
+
+void TIMER_Enable_CPU_WKUP(void)
+{
+}
+
+void TIMER_Disable_CPU_WKUP(void)
+{
+}
+
+uint64_t TIMER_GetAnchorPoint(void)
+{
+  return TIMER_SIM_Context.last_anchor_time;
+}
+
+uint32_t TIMER_SysTimeToMachineTime(int32_t time)
+{
+  return (uint32_t)time;
+}
+
+uint32_t TIMER_MachineTimeToSysTime(uint32_t time)
+{
+  return time;
+}
+
+uint32_t TIMER_UsToSystime(uint32_t time)
+{
+  return us_to_systime(time);
+}
+
+uint32_t TIMER_UsToMachinetime(uint32_t time)
+{
+  return us_to_systime(time);
+}
+
+void TIMER_SIM_SetCurrentSysTime(uint64_t time)
+{
+  TIMER_SIM_Context.current_time = time;
+}
+
+void TIMER_SIM_Advance(uint64_t delay)
+{
+  uint64_t target = TIMER_SIM_Context.current_time + delay;
+  uint64_t time;
+
+  while (TIMER_SIM_GetNextEventTime(&time) && (time <= target)) {
+    /* A timer programmed in the past triggers immediately */
+    if (time > TIMER_SIM_Context.current_time) {
+      TIMER_SIM_Context.current_time = time;
+    }
+    /* The host timer is served first when both timers expire together */
+    if (TIMER_SIM_Context.host_enabled && (TIMER_SIM_Context.host_time == time)) {
+      TIMER_SIM_Context.host_enabled = FALSE;
+      HAL_VTIMER_TimeoutCallback();
+    }
+    else {
+      /* The simulated radio activity has no duration */
+      TIMER_SIM_Context.radio_enabled = FALSE;
+      HAL_VTIMER_EndOfRadioActivityIsr();
+      HAL_VTIMER_RadioTimerIsr();
+    }
+  }
+  TIMER_SIM_Context.current_time = target;
+}
+
+BOOL TIMER_SIM_GetNextEventTime(uint64_t *time)
+{
+  if (TIMER_SIM_Context.host_enabled && TIMER_SIM_Context.radio_enabled) {
+    *time = MIN(TIMER_SIM_Context.host_time, TIMER_SIM_Context.radio_time);
+  }
+  else if (TIMER_SIM_Context.host_enabled) {
+    *time = TIMER_SIM_Context.host_time;
+  }
+  else if (TIMER_SIM_Context.radio_enabled) {
+    *time = TIMER_SIM_Context.radio_time;
+  }
+  else {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void TIMER_SIM_DisableHostTimer(void)
+{
+  TIMER_SIM_Context.host_enabled = FALSE;
+}
+
+BOOL TIMER_SIM_IsRadioTimerEnabled(void)
+{
+  return TIMER_SIM_Context.radio_enabled;
+}
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif /* TIMER_SIM_ENABLE */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
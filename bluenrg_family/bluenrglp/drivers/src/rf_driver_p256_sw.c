@@ -0,0 +1,452 @@
+/**
+  ******************************************************************************
+  * @file    rf_driver_p256_sw.c
+  * @author  RF Application Team
+  * @brief   Portable P-256 scalar multiplication
+  * @details The point multiplication done by the PKA is implemented on the CPU,
+  * with the same input and output formats as the PKA RAM. It is used by the
+  * software implementation of the PKA HAL (rf_driver_hal_pka_sw.c) to run
+  * off-target, and it can compute a point multiplication while the PKA is busy.
+  * The field elements are kept in the Montgomery domain (R = 2^256) and the
+  * points in Jacobian coordinates. The scalar multiplication is a Montgomery
+  * ladder with conditional swaps, on a scalar extended to 257 bits with a
+  * multiple of the order of the curve: the sequence of operations does not
+  * depend on the value of the scalar.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+#include "rf_driver_p256_sw.h"
+
+#define W                          P256_SW_WORDS
+
+/* Point in Jacobian coordinates, in the Montgomery domain. Z is 0 for the point at infinity. */
+typedef struct {
+  uint32_t x[W];
+  uint32_t y[W];
+  uint32_t z[W];
+} P256_PointType;
+
+/* Modulus p = 2^256 - 2^224 + 2^192 + 2^96 - 1. As p = -1 mod 2^32, -1/p mod 2^32 is 1. */
+static const uint32_t P256_P[W] = {
+  0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000001U, 0xFFFFFFFFU};
+
+/* Order of the curve */
+static const uint32_t P256_N[W] = {
+  0xFC632551U, 0xF3B9CAC2U, 0xA7179E84U, 0xBCE6FAADU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0x00000000U, 0xFFFFFFFFU};
+
+/* R^2 mod p, converts to the Montgomery domain */
+static const uint32_t P256_R2[W] = {
+  0x00000003U, 0x00000000U, 0xFFFFFFFFU, 0xFFFFFFFBU, 0xFFFFFFFEU, 0xFFFFFFFFU, 0xFFFFFFFDU, 0x00000004U};
+
+/* 1 in the Montgomery domain (R mod p) */
+static const uint32_t P256_ONE_MONT[W] = {
+  0x00000001U, 0x00000000U, 0x00000000U, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFEU, 0x00000000U};
+
+/* Coefficient b in the Montgomery domain. The coefficient a is -3. */
+static const uint32_t P256_B_MONT[W] = {
+  0x29C4BDDFU, 0xD89CDF62U, 0x78843090U, 0xACF005CDU, 0xF7212ED6U, 0xE5A220ABU, 0x04874834U, 0xDC30061DU};
+
+static const uint32_t P256_ONE[W] = {1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U};
+
+/* r = a + b, returns the carry */
+static uint32_t BnAdd(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+  uint64_t acc = 0;
+  uint32_t i;
+
+  for(i = 0; i < W; i++) {
+    acc += (uint64_t)a[i] + b[i];
+    r[i] = (uint32_t)acc;
+    acc >>= 32;
+  }
+  return (uint32_t)acc;
+}
+
+/* r = a - b, returns the borrow */
+static uint32_t BnSub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+  uint64_t diff;
+  uint32_t borrow = 0, i;
+
+  for(i = 0; i < W; i++) {
+    diff = (uint64_t)a[i] - b[i] - borrow;
+    r[i] = (uint32_t)diff;
+    borrow = (uint32_t)(diff >> 32) & 1U;
+  }
+  return borrow;
+}
+
+/* r = a if mask is all ones, b if mask is 0 */
+static void BnSelect(uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t mask)
+{
+  uint32_t i;
+
+  for(i = 0; i < W; i++) {
+    r[i] = (a[i] & mask) | (b[i] & ~mask);
+  }
+}
+
+static uint32_t BnIsZero(const uint32_t *a)
+{
+  uint32_t acc = 0, i;
+
+  for(i = 0; i < W; i++) {
+    acc |= a[i];
+  }
+  return (acc == 0U);
+}
+
+static uint32_t BnIsLower(const uint32_t *a, const uint32_t *b)
+{
+  uint32_t t[W];
+
+  return BnSub(t, a, b);
+}
+
+static void FeAdd(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+  uint32_t t[W], carry, borrow;
+
+  carry = BnAdd(r, a, b);
+  borrow = BnSub(t, r, P256_P);
+  BnSelect(r, t, r, 0U - (carry | (borrow ^ 1U)));
+}
+
+static void FeSub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+  uint32_t t[W], borrow;
+
+  borrow = BnSub(r, a, b);
+  BnAdd(t, r, P256_P);
+  BnSelect(r, t, r, 0U - borrow);
+}
+
+/* Montgomery multiplication: r = a.b/R mod p. r can be the same as a or b. */
+static void FeMul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+  uint32_t t[W + 2] = {0};
+  uint32_t u[W], i, j, m, borrow;
+  uint64_t acc, carry;
+
+  for(i = 0; i < W; i++) {
+    carry = 0;
+    for(j = 0; j < W; j++) {
+      acc = (uint64_t)a[j] * b[i] + t[j] + carry;
+      t[j] = (uint32_t)acc;
+      carry = acc >> 32;
+    }
+    acc = (uint64_t)t[W] + carry;
+    t[W] = (uint32_t)acc;
+    t[W + 1] = (uint32_t)(acc >> 32);
+
+    /* Add m.p so that the least significant word is 0, and shift by one word */
+    m = t[0];
+    acc = (uint64_t)m * P256_P[0] + t[0];
+    carry = acc >> 32;
+    for(j = 1; j < W; j++) {
+      acc = (uint64_t)m * P256_P[j] + t[j] + carry;
+      t[j - 1] = (uint32_t)acc;
+      carry = acc >> 32;
+    }
+    acc = (uint64_t)t[W] + carry;
+    t[W - 1] = (uint32_t)acc;
+    t[W] = t[W + 1] + (uint32_t)(acc >> 32);
+  }
+
+  borrow = BnSub(u, t, P256_P);
+  BnSelect(r, u, t, 0U - (t[W] | (borrow ^ 1U)));
+}
+
+static void FeSqr(uint32_t *r, const uint32_t *a)
+{
+  FeMul(r, a, a);
+}
+
+/* r = 1/a, with a^(p-2) */
+static void FeInv(uint32_t *r, const uint32_t *a)
+{
+  uint32_t e[W], t[W], i;
+
+  BnSub(e, P256_P, P256_ONE);
+  BnSub(e, e, P256_ONE);
+  for(i = 0; i < W; i++) {
+    t[i] = P256_ONE_MONT[i];
+  }
+  for(i = W * 32U; i > 0U; i--) {
+    FeSqr(t, t);
+    if(((e[(i - 1U) >> 5] >> ((i - 1U) & 31U)) & 1U) != 0U) {
+      FeMul(t, t, a);
+    }
+  }
+  for(i = 0; i < W; i++) {
+    r[i] = t[i];
+  }
+}
+
+/* r = 2a, with the formula dbl-2001-b for a = -3. r can be the same as a. */
+static void PointDouble(P256_PointType *r, const P256_PointType *a)
+{
+  uint32_t delta[W], gamma[W], beta[W], alpha[W], t1[W], t2[W];
+
+  FeSqr(delta, a->z);
+  FeSqr(gamma, a->y);
+  FeMul(beta, a->x, gamma);
+
+  /* alpha = 3.(X - delta).(X + delta) */
+  FeSub(t1, a->x, delta);
+  FeAdd(t2, a->x, delta);
+  FeMul(t1, t1, t2);
+  FeAdd(alpha, t1, t1);
+  FeAdd(alpha, alpha, t1);
+
+  /* Z3 = (Y + Z)^2 - gamma - delta */
+  FeAdd(t1, a->y, a->z);
+  FeSqr(t1, t1);
+  FeSub(t1, t1, gamma);
+  FeSub(r->z, t1, delta);
+
+  /* X3 = alpha^2 - 8.beta */
+  FeAdd(beta, beta, beta);
+  FeAdd(beta, beta, beta);
+  FeSqr(t1, alpha);
+  FeAdd(t2, beta, beta);
+  FeSub(r->x, t1, t2);
+
+  /* Y3 = alpha.(4.beta - X3) - 8.gamma^2 */
+  FeSub(t1, beta, r->x);
+  FeMul(t1, alpha, t1);
+  FeSqr(t2, gamma);
+  FeAdd(t2, t2, t2);
+  FeAdd(t2, t2, t2);
+  FeAdd(t2, t2, t2);
+  FeSub(r->y, t1, t2);
+}
+
+/* r = a + b, with the formula add-2007-bl. r can be the same as a or b.
+   The point at infinity and the doubling are handled by branches: in the ladder,
+   they only occur for a negligible set of scalars. */
+static void PointAdd(P256_PointType *r, const P256_PointType *a, const P256_PointType *b)
+{
+  uint32_t z1z1[W], z2z2[W], u1[W], u2[W], s1[W], s2[W], h[W], i[W], j[W], rr[W], v[W], t[W];
+
+  if(BnIsZero(a->z)) {
+    *r = *b;
+    return;
+  }
+  if(BnIsZero(b->z)) {
+    *r = *a;
+    return;
+  }
+
+  FeSqr(z1z1, a->z);
+  FeSqr(z2z2, b->z);
+  FeMul(u1, a->x, z2z2);
+  FeMul(u2, b->x, z1z1);
+  FeMul(s1, a->y, b->z);
+  FeMul(s1, s1, z2z2);
+  FeMul(s2, b->y, a->z);
+  FeMul(s2, s2, z1z1);
+  FeSub(h, u2, u1);
+  FeSub(rr, s2, s1);
+
+  if(BnIsZero(h)) {
+    if(BnIsZero(rr)) {
+      PointDouble(r, a);
+    }
+    else {
+      BnSub(r->z, r->z, r->z);
+    }
+    return;
+  }
+
+  FeAdd(i, h, h);
+  FeSqr(i, i);
+  FeMul(j, h, i);
+  FeAdd(rr, rr, rr);
+  FeMul(v, u1, i);
+
+  /* Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2).H */
+  FeAdd(t, a->z, b->z);
+  FeSqr(t, t);
+  FeSub(t, t, z1z1);
+  FeSub(t, t, z2z2);
+  FeMul(r->z, t, h);
+
+  /* X3 = r^2 - J - 2.V */
+  FeSqr(t, rr);
+  FeSub(t, t, j);
+  FeSub(t, t, v);
+  FeSub(r->x, t, v);
+
+  /* Y3 = r.(V - X3) - 2.S1.J */
+  FeSub(t, v, r->x);
+  FeMul(t, rr, t);
+  FeMul(s1, s1, j);
+  FeAdd(s1, s1, s1);
+  FeSub(r->y, t, s1);
+}
+
+/* Swap a and b if mask is all ones */
+static void PointSwap(P256_PointType *a, P256_PointType *b, uint32_t mask)
+{
+  uint32_t *pa = (uint32_t *)a, *pb = (uint32_t *)b;
+  uint32_t i, t;
+
+  for(i = 0; i < 3U * W; i++) {
+    t = (pa[i] ^ pb[i]) & mask;
+    pa[i] ^= t;
+    pb[i] ^= t;
+  }
+}
+
+/**
+* @brief  This routine checks that a point is on the curve.
+* @param  point: X and Y coordinates, 16 words.
+* @retval P256_SW_SUCCESS or P256_SW_ERROR_POINT
+*/
+uint32_t P256_SW_PointCheck(const uint32_t *point)
+{
+  uint32_t x[W], y[W], lhs[W], rhs[W], t[W];
+
+  if(!BnIsLower(point, P256_P) || !BnIsLower(&point[W], P256_P)) {
+    return P256_SW_ERROR_POINT;
+  }
+
+  FeMul(x, point, P256_R2);
+  FeMul(y, &point[W], P256_R2);
+
+  /* y^2 = x^3 - 3.x + b */
+  FeSqr(lhs, y);
+  FeSqr(rhs, x);
+  FeMul(rhs, rhs, x);
+  FeAdd(t, x, x);
+  FeAdd(t, t, x);
+  FeSub(rhs, rhs, t);
+  FeAdd(rhs, rhs, P256_B_MONT);
+  FeSub(t, lhs, rhs);
+
+  return BnIsZero(t) ? P256_SW_SUCCESS : P256_SW_ERROR_POINT;
+}
+
+/**
+* @brief  This routine multiplies a point of the curve by a scalar.
+*         The result is the same as with the PKA.
+* @param[out] result: X and Y coordinates of k.P, 16 words. It is not written in case of error.
+* @param  k: scalar, 8 words, from 1 to the order of the curve - 1.
+* @param  point: X and Y coordinates of P, 16 words.
+* @retval P256_SW_SUCCESS, P256_SW_ERROR_POINT or P256_SW_ERROR_SCALAR
+*/
+uint32_t P256_SW_PointMul(uint32_t *result, const uint32_t *k, const uint32_t *point)
+{
+  P256_PointType r0, r1;
+  uint32_t k1[W], k2[W], zinv[W], t[W];
+  uint32_t status, carry, bit, swap, i;
+
+  status = P256_SW_PointCheck(point);
+  if(status != P256_SW_SUCCESS) {
+    return status;
+  }
+  if(BnIsZero(k) || !BnIsLower(k, P256_N)) {
+    return P256_SW_ERROR_SCALAR;
+  }
+
+  /* k + n or k + 2n, whichever has the bit 256 set: the ladder always starts on bit 255 */
+  carry = BnAdd(k1, k, P256_N);
+  BnAdd(k2, k1, P256_N);
+  BnSelect(k1, k1, k2, 0U - carry);
+
+  /* R0 = P, R1 = 2.P */
+  FeMul(r0.x, point, P256_R2);
+  FeMul(r0.y, &point[W], P256_R2);
+  for(i = 0; i < W; i++) {
+    r0.z[i] = P256_ONE_MONT[i];
+  }
+  PointDouble(&r1, &r0);
+
+  swap = 0;
+  for(i = W * 32U; i > 0U; i--) {
+    bit = (k1[(i - 1U) >> 5] >> ((i - 1U) & 31U)) & 1U;
+    PointSwap(&r0, &r1, 0U - (swap ^ bit));
+    swap = bit;
+    PointAdd(&r1, &r0, &r1);
+    PointDouble(&r0, &r0);
+  }
+  PointSwap(&r0, &r1, 0U - swap);
+
+  /* Back to affine coordinates, out of the Montgomery domain */
+  FeInv(zinv, r0.z);
+  FeSqr(t, zinv);
+  FeMul(r0.x, r0.x, t);
+  FeMul(t, t, zinv);
+  FeMul(r0.y, r0.y, t);
+  FeMul(result, r0.x, P256_ONE);
+  FeMul(&result[W], r0.y, P256_ONE);
+
+  return P256_SW_SUCCESS;
+}
+
+/* NIST CAVS ECC CDH test vector P-256, COUNT = 0 */
+static const uint32_t P256_KAT_D[W] = {
+  0x2BC1A534U, 0xD80BADB6U, 0x1FB6D22EU, 0x3D9058AFU, 0x632EEAE0U, 0xF80D6214U, 0x1EB29DDAU, 0x7D7DC5F7U};
+static const uint32_t P256_KAT_G[2U * W] = {
+  0xD898C296U, 0xF4A13945U, 0x2DEB33A0U, 0x77037D81U, 0x63A440F2U, 0xF8BCE6E5U, 0xE12C4247U, 0x6B17D1F2U,
+  0x37BF51F5U, 0xCBB64068U, 0x6B315ECEU, 0x2BCE3357U, 0x7C0F9E16U, 0x8EE7EB4AU, 0xFE1A7F9BU, 0x4FE342E2U};
+static const uint32_t P256_KAT_Q_IUT[2U * W] = {
+  0xD8A6B230U, 0x385ED281U, 0xF97D38CEU, 0x70C4EDBBU, 0xF89CA617U, 0x6B29146FU, 0x0119E887U, 0xEAD21859U,
+  0xE1405141U, 0x9F59EDFCU, 0x64832538U, 0x9CB06EE6U, 0xACC85A42U, 0xA7002523U, 0x1FD35E2FU, 0x28AF6128U};
+static const uint32_t P256_KAT_Q_CAVS[2U * W] = {
+  0x8833D287U, 0x2CE7CC83U, 0x3A4DF6B4U, 0x1B6BACCEU, 0x65640DB9U, 0x5CC632CAU, 0x7F56584CU, 0x700C48F7U,
+  0xB85FA4ACU, 0x441782CAU, 0xF640DFE0U, 0x948D46FBU, 0x5C51DCC5U, 0x0DDB20BAU, 0xE3FD9B06U, 0xDB71E509U};
+static const uint32_t P256_KAT_Z[W] = {
+  0x8997BD7BU, 0x040DD777U, 0x60561E68U, 0xCCC58520U, 0xFBDD2D25U, 0x2E54A434U, 0x6420FF01U, 0x46FC6210U};
+
+/**
+* @brief  This routine checks the point multiplication against a NIST known answer:
+*         the public key and the shared secret of a CAVS ECC CDH P-256 vector are computed,
+*         and a point not on the curve must be rejected.
+* @retval P256_SW_SUCCESS or P256_SW_ERROR_SELFTEST
+*/
+uint32_t P256_SW_SelfTest(void)
+{
+  uint32_t result[2U * W], point[2U * W];
+  uint32_t diff = 0U, i;
+
+  /* Public key: d.G */
+  if(P256_SW_PointMul(result, P256_KAT_D, P256_KAT_G) != P256_SW_SUCCESS) {
+    return P256_SW_ERROR_SELFTEST;
+  }
+  for(i = 0; i < 2U * W; i++) {
+    diff |= result[i] ^ P256_KAT_Q_IUT[i];
+  }
+
+  /* Shared secret: X coordinate of d.Q */
+  if(P256_SW_PointMul(result, P256_KAT_D, P256_KAT_Q_CAVS) != P256_SW_SUCCESS) {
+    return P256_SW_ERROR_SELFTEST;
+  }
+  for(i = 0; i < W; i++) {
+    diff |= result[i] ^ P256_KAT_Z[i];
+  }
+
+  /* The same point with another Y coordinate is not on the curve */
+  for(i = 0; i < 2U * W; i++) {
+    point[i] = P256_KAT_Q_CAVS[i];
+  }
+  point[W] ^= 1U;
+  if(P256_SW_PointMul(result, P256_KAT_D, point) != P256_SW_ERROR_POINT) {
+    diff |= 1U;
+  }
+
+  return (diff == 0U) ? P256_SW_SUCCESS : P256_SW_ERROR_SELFTEST;
+}
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
@@ -31,6 +31,32 @@ typedef struct circular_fifo_s {
   uint8_t alignment;
 } circular_fifo_t;
 
+/* One source segment of a scattered variable length item */
+typedef struct fifo_iovec_s {
+  uint8_t *buffer;
+  uint16_t size;
+} fifo_iovec_t;
+
+/* Single-producer/single-consumer variant of circular_fifo_t.
+ * The producer (e.g. an ISR) only writes tail, the consumer only writes head,
+ * so no atomic section is needed as long as there is exactly one of each. */
+typedef struct circular_fifo_spsc_s {
+  volatile uint16_t tail;
+  volatile uint16_t head;
+  uint16_t max_size;
+  uint8_t *buffer;
+  uint8_t alignment;
+} circular_fifo_spsc_t;
+
+/* Orders the accesses to the FIFO storage with respect to the update of head/tail,
+ * so that the other side never sees an index before the data it refers to. */
+#if defined(__GNUC__)
+#define FIFO_SPSC_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#include "cmsis_compiler.h"
+#define FIFO_SPSC_BARRIER() __DMB()
+#endif
+
 void fifo_init(circular_fifo_t *fifo, uint16_t max_size, uint8_t  *buffer, uint8_t alignment);
 uint16_t fifo_size(circular_fifo_t *fifo);
 uint8_t fifo_put(circular_fifo_t *fifo, uint16_t size, uint8_t  *buffer);
@@ -42,4 +68,19 @@ uint8_t fifo_get_var_len_item(circular_fifo_t *fifo, uint16_t *size, uint8_t  *b
 uint8_t fifo_get_ptr_var_len_item(circular_fifo_t *fifo, uint16_t *size, uint8_t  **ptr);
 uint8_t fifo_discard_var_len_item(circular_fifo_t *fifo);
 void fifo_flush(circular_fifo_t *fifo);
+uint8_t fifo_reserve_var_len_item(circular_fifo_t *fifo, uint16_t max_size, uint8_t **ptr);
+uint8_t fifo_commit(circular_fifo_t *fifo, uint16_t size);
+uint8_t fifo_peek(circular_fifo_t *fifo, uint16_t *size, uint8_t **ptr);
+uint8_t fifo_release(circular_fifo_t *fifo);
+uint8_t fifo_put_var_len_item_iov(circular_fifo_t *fifo, const fifo_iovec_t *iov, uint8_t iovcnt);
+uint16_t fifo_get_var_len_items(circular_fifo_t *fifo, uint8_t *buffer, uint16_t buffer_size, uint16_t *length);
+uint16_t fifo_discard_var_len_items(circular_fifo_t *fifo, uint16_t count);
+
+void fifo_spsc_init(circular_fifo_spsc_t *fifo, uint16_t max_size, uint8_t  *buffer, uint8_t alignment);
+uint16_t fifo_spsc_size(circular_fifo_spsc_t *fifo);
+uint8_t fifo_spsc_put(circular_fifo_spsc_t *fifo, uint16_t size, uint8_t  *buffer);
+uint8_t fifo_spsc_put_var_len_item(circular_fifo_spsc_t *fifo, uint16_t size1, uint8_t  *buffer1, uint16_t size2, uint8_t  *buffer2);
+uint8_t fifo_spsc_get(circular_fifo_spsc_t *fifo, uint16_t size, uint8_t  *buffer);
+uint8_t fifo_spsc_get_var_len_item(circular_fifo_spsc_t *fifo, uint16_t *size, uint8_t  *buffer);
+uint8_t fifo_spsc_discard_var_len_item(circular_fifo_spsc_t *fifo);
 #endif /* __FIFO_H__ */
@@ -0,0 +1,71 @@
+/**
+******************************************************************************
+* @file    blue_unit_conversion.c
+* @author  RF Application Team
+* @brief   Portable version of blue_unit_conversion.s
+* @details blue_unit_conversion translates a quantity expressed in STU into MTU, or
+* vice-versa, multiplying it by a frequency or a period in fixed point with 21
+* fractional bits and rounding to the nearest integer.
+* The result is bit-exact with the Thumb implementation for any input, including
+* the truncations of the original routine:
+* - up to the threshold the product is computed on 32 bits only,
+* - above the threshold the carry of the sum of the cross products is dropped.
+* The Thumb implementation is built instead when CONFIG_BLUENRG_LP_BLUE_UNIT_CONVERSION_ASM is set.
+******************************************************************************
+* @attention
+*
+* THE PRESENT FIRMWARE WHICH IS FOR GUIDANCE ONLY AIMS AT PROVIDING CUSTOMERS
+* WITH CODING INFORMATION REGARDING THEIR PRODUCTS IN ORDER FOR THEM TO SAVE
+* TIME. AS A RESULT, STMICROELECTRONICS SHALL NOT BE HELD LIABLE FOR ANY
+* DIRECT, INDIRECT OR CONSEQUENTIAL DAMAGES WITH RESPECT TO ANY CLAIMS ARISING
+* FROM THE CONTENT OF SUCH FIRMWARE AND/OR THE USE MADE BY CUSTOMERS OF THE
+* CODING INFORMATION CONTAINED HEREIN IN CONNECTION WITH THEIR PRODUCTS.
+*
+* <h2><center>&copy; COPYRIGHT 2020 STMicroelectronics</center></h2>
+******************************************************************************
+*/
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "rf_driver_ll_timer.h"
+
+#ifndef CONFIG_BLUENRG_LP_BLUE_UNIT_CONVERSION_ASM
+
+/* Rounding constant: one half in fixed point with 21 fractional bits */
+#define BLUE_UNIT_ROUND   (0x00100000U)
+#define BLUE_UNIT_SHIFT   (21U)
+
+/**
+ * blue_unit_conversion
+ * Return (time * period_freq + 2^20) >> 21. When time is not larger than thr the
+ * product fits in 32 bits for the values used by the timer driver and a single
+ * multiplication is done. Otherwise the 64-bit product is built from the four
+ * 16x16 partial products, as the core has no long multiplication instruction.
+ */
+uint32_t blue_unit_conversion(uint32_t time, uint32_t period_freq, uint32_t thr)
+{
+  uint32_t time_lo, time_hi, pf_lo, pf_hi;
+  uint32_t cross, cross_lo, lo, hi;
+  uint64_t product;
+
+  if (time <= thr) {
+    return (time * period_freq + BLUE_UNIT_ROUND) >> BLUE_UNIT_SHIFT;
+  }
+
+  time_lo = time & 0xFFFFU;
+  time_hi = time >> 16;
+  pf_lo = period_freq & 0xFFFFU;
+  pf_hi = period_freq >> 16;
+
+  /* The carry of this sum is not propagated by the original routine */
+  cross = (pf_lo * time_hi) + (time_lo * pf_hi);
+  cross_lo = cross << 16;
+  lo = cross_lo + (pf_lo * time_lo);
+  hi = (time_hi * pf_hi) + (cross >> 16) + ((lo < cross_lo) ? 1U : 0U);
+
+  product = (((uint64_t)hi) << 32) | lo;
+  return (uint32_t)((product + BLUE_UNIT_ROUND) >> BLUE_UNIT_SHIFT);
+}
+
+#endif /* CONFIG_BLUENRG_LP_BLUE_UNIT_CONVERSION_ASM */
+
+/******************* (C) COPYRIGHT 2020 STMicroelectronics *****END OF FILE****/
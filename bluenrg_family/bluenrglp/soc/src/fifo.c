@@ -28,6 +28,7 @@
 #define FIFO_ALIGNMENT fifo->alignment
 #define FIFO_GET_SIZE(fifo) ((fifo->tail>=fifo->head) ? (fifo->tail - fifo->head) : (fifo->max_size - (fifo->head - fifo->tail)))
 #define VAR_LEN_ITEM_SIZE_LENGTH 2
+#define FIFO_SPSC_SIZE(tail, head, max_size) (((tail) >= (head)) ? ((tail) - (head)) : ((max_size) - ((head) - (tail))))
 
 /**
 * @brief  Initiliaze a circular fifo specfiyng also elements alignment
@@ -176,3 +177,316 @@ uint8_t fifo_discard_var_len_item(circular_fifo_t *fifo)
   }
   return ret_val;
 }
+
+/**
+* @brief  Reserve room for a variable length item and return a pointer to its payload,
+* so that the producer can write it in place instead of copying it.
+* The payload area is always linear thanks to the extra room after max_size.
+* The item becomes visible only after fifo_commit().
+* @param  max_size: maximum payload length the producer may write
+* @param  ptr: filled with the address of the payload area
+* @retval 0 on success, 1 if there is not enough room
+*/
+uint8_t fifo_reserve_var_len_item(circular_fifo_t *fifo, uint16_t max_size, uint8_t **ptr)
+{
+  uint16_t size_aligned = FIFO_ALIGN(max_size, FIFO_ALIGNMENT);
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  if ((FIFO_GET_SIZE(fifo) + size_aligned + length_size_aligned) < fifo->max_size) {
+    *ptr = &fifo->buffer[fifo->tail + length_size_aligned];
+    return 0;
+  }
+  return 1;
+}
+
+/**
+* @brief  Commit the item previously reserved with fifo_reserve_var_len_item().
+* @param  size: actual payload length. It must not exceed the reserved length.
+* @retval 0 on success, 1 if there is not enough room
+*/
+uint8_t fifo_commit(circular_fifo_t *fifo, uint16_t size)
+{
+  uint16_t size_aligned = FIFO_ALIGN(size, FIFO_ALIGNMENT);
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  if ((FIFO_GET_SIZE(fifo) + size_aligned + length_size_aligned) < fifo->max_size) {
+    Osal_MemCpy(&fifo->buffer[fifo->tail], &size, VAR_LEN_ITEM_SIZE_LENGTH);
+    fifo->tail = ADVANCE_QUEUE(fifo->tail, size_aligned + length_size_aligned, fifo->max_size);
+    return 0;
+  }
+  return 1;
+}
+
+/**
+* @brief  Return the length and the payload address of the oldest variable length item
+* without removing it. The payload stays valid until fifo_release() is called.
+* @retval 0 on success, 1 if the fifo is empty
+*/
+uint8_t fifo_peek(circular_fifo_t *fifo, uint16_t *size, uint8_t **ptr)
+{
+  uint16_t index;
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  if (FIFO_GET_SIZE(fifo) < length_size_aligned) {
+    return 1;
+  }
+  Osal_MemCpy(size, &fifo->buffer[fifo->head], VAR_LEN_ITEM_SIZE_LENGTH);
+  if (FIFO_GET_SIZE(fifo) < (length_size_aligned + FIFO_ALIGN(*size, FIFO_ALIGNMENT))) {
+    return 1;
+  }
+  index = ADVANCE_QUEUE(fifo->head, length_size_aligned, fifo->max_size);
+  *ptr = &fifo->buffer[(index == 0) ? fifo->max_size : index];
+  return 0;
+}
+
+/**
+* @brief  Remove the item returned by fifo_peek().
+* @retval 0 on success, 1 if the fifo is empty
+*/
+uint8_t fifo_release(circular_fifo_t *fifo)
+{
+  return fifo_discard_var_len_item(fifo);
+}
+
+/**
+* @brief  Put a variable length item gathered from iovcnt segments in the fifo.
+* Generalization of fifo_put_var_len_item() to any number of segments.
+* @retval 0 on success, 1 if there is not enough room
+*/
+uint8_t fifo_put_var_len_item_iov(circular_fifo_t *fifo, const fifo_iovec_t *iov, uint8_t iovcnt)
+{
+  uint16_t size = 0;
+  uint16_t size_aligned, index;
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+  uint8_t i;
+
+  for (i = 0; i < iovcnt; i++) {
+    size += iov[i].size;
+  }
+  size_aligned = FIFO_ALIGN(size, FIFO_ALIGNMENT);
+
+  if ((FIFO_GET_SIZE(fifo) + size_aligned + length_size_aligned) < fifo->max_size) {
+    Osal_MemCpy(&fifo->buffer[fifo->tail], &size, VAR_LEN_ITEM_SIZE_LENGTH);
+    index = fifo->tail + length_size_aligned;
+    for (i = 0; i < iovcnt; i++) {
+      Osal_MemCpy(&fifo->buffer[index], iov[i].buffer, iov[i].size);
+      index += iov[i].size;
+    }
+    fifo->tail = ADVANCE_QUEUE(fifo->tail, size_aligned + length_size_aligned, fifo->max_size);
+    return 0;
+  }
+  return 1;
+}
+
+/**
+* @brief  Drain as many whole variable length items as fit in the caller buffer.
+* Each item is copied as its 2 bytes length followed by its payload, without padding.
+* The head is updated only once at the end.
+* @param  buffer: destination buffer
+* @param  buffer_size: size of the destination buffer
+* @param  length: filled with the number of bytes written in buffer
+* @retval Number of items copied
+*/
+uint16_t fifo_get_var_len_items(circular_fifo_t *fifo, uint8_t *buffer, uint16_t buffer_size, uint16_t *length)
+{
+  uint16_t head = fifo->head;
+  uint16_t available = FIFO_GET_SIZE(fifo);
+  uint16_t written = 0;
+  uint16_t count = 0;
+  uint16_t size, item_aligned, index;
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  while (available >= length_size_aligned) {
+    Osal_MemCpy(&size, &fifo->buffer[head], VAR_LEN_ITEM_SIZE_LENGTH);
+    item_aligned = length_size_aligned + FIFO_ALIGN(size, FIFO_ALIGNMENT);
+    if ((available < item_aligned) || ((buffer_size - written) < (size + VAR_LEN_ITEM_SIZE_LENGTH))) {
+      break;
+    }
+    index = ADVANCE_QUEUE(head, length_size_aligned, fifo->max_size);
+    Osal_MemCpy(&buffer[written], &size, VAR_LEN_ITEM_SIZE_LENGTH);
+    Osal_MemCpy(&buffer[written + VAR_LEN_ITEM_SIZE_LENGTH], &fifo->buffer[(index == 0) ? fifo->max_size : index], size);
+    written += size + VAR_LEN_ITEM_SIZE_LENGTH;
+    head = ADVANCE_QUEUE(head, item_aligned, fifo->max_size);
+    available -= item_aligned;
+    count++;
+  }
+  fifo->head = head;
+  *length = written;
+  return count;
+}
+
+/**
+* @brief  Drop up to count variable length items, updating the head only once.
+* @retval Number of items discarded
+*/
+uint16_t fifo_discard_var_len_items(circular_fifo_t *fifo, uint16_t count)
+{
+  uint16_t head = fifo->head;
+  uint16_t available = FIFO_GET_SIZE(fifo);
+  uint16_t discarded = 0;
+  uint16_t size, item_aligned;
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  while ((discarded < count) && (available >= length_size_aligned)) {
+    Osal_MemCpy(&size, &fifo->buffer[head], VAR_LEN_ITEM_SIZE_LENGTH);
+    item_aligned = length_size_aligned + FIFO_ALIGN(size, FIFO_ALIGNMENT);
+    if (available < item_aligned) {
+      break;
+    }
+    head = ADVANCE_QUEUE(head, item_aligned, fifo->max_size);
+    available -= item_aligned;
+    discarded++;
+  }
+  fifo->head = head;
+  return discarded;
+}
+
+/**
+* @brief  Initialize a single-producer/single-consumer circular fifo.
+* Same buffer sizing rules as fifo_init(): max_size + maximum length of element.
+* @retval None
+*/
+void fifo_spsc_init(circular_fifo_spsc_t *fifo, uint16_t max_size, uint8_t  *buffer, uint8_t alignment)
+{
+  fifo->tail = fifo->head = 0;
+  fifo->max_size = max_size;
+  fifo->buffer = buffer;
+  fifo->alignment = alignment;
+}
+
+/**
+* @brief  Return number of bytes held in the SPSC FIFO. Can be called from both sides.
+* @retval Number of bytes
+*/
+uint16_t fifo_spsc_size(circular_fifo_spsc_t *fifo)
+{
+  uint16_t tail = fifo->tail;
+  uint16_t head = fifo->head;
+  return FIFO_SPSC_SIZE(tail, head, fifo->max_size);
+}
+
+/**
+* @brief  Put the buffer in the SPSC fifo. Producer side only.
+* @retval 0 on success, 1 if there is not enough room
+*/
+uint8_t fifo_spsc_put(circular_fifo_spsc_t *fifo, uint16_t size, uint8_t  *buffer)
+{
+  uint16_t tail = fifo->tail;
+  uint16_t head = fifo->head;
+  uint16_t size_aligned = FIFO_ALIGN(size, FIFO_ALIGNMENT);
+
+  if ((FIFO_SPSC_SIZE(tail, head, fifo->max_size) + size_aligned) < fifo->max_size) {
+    /* Do not touch the storage before the consumer has released it */
+    FIFO_SPSC_BARRIER();
+    Osal_MemCpy(&fifo->buffer[tail], buffer, size);
+    FIFO_SPSC_BARRIER();
+    fifo->tail = ADVANCE_QUEUE(tail, size_aligned, fifo->max_size);
+    return 0;
+  }
+  return 1;
+}
+
+/**
+* @brief  Put a variable length item made of two segments in the SPSC fifo. Producer side only.
+* @retval 0 on success, 1 if there is not enough room
+*/
+uint8_t fifo_spsc_put_var_len_item(circular_fifo_spsc_t *fifo, uint16_t size1, uint8_t  *buffer1, uint16_t size2, uint8_t  *buffer2)
+{
+  uint16_t tail = fifo->tail;
+  uint16_t head = fifo->head;
+  uint16_t size = size1 + size2;
+  uint16_t size_aligned = FIFO_ALIGN(size, FIFO_ALIGNMENT);
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  if ((FIFO_SPSC_SIZE(tail, head, fifo->max_size) + size_aligned + length_size_aligned) < fifo->max_size) {
+    FIFO_SPSC_BARRIER();
+    Osal_MemCpy(&fifo->buffer[tail], &size, VAR_LEN_ITEM_SIZE_LENGTH);
+    Osal_MemCpy(&fifo->buffer[tail + length_size_aligned], buffer1, size1);
+    Osal_MemCpy(&fifo->buffer[tail + length_size_aligned + size1], buffer2, size2);
+    /* Publish the whole item at once */
+    FIFO_SPSC_BARRIER();
+    fifo->tail = ADVANCE_QUEUE(tail, size_aligned + length_size_aligned, fifo->max_size);
+    return 0;
+  }
+  return 1;
+}
+
+/**
+* @brief  Get size bytes from the SPSC fifo. Consumer side only.
+* @retval 0 on success, 1 if not enough data
+*/
+uint8_t fifo_spsc_get(circular_fifo_spsc_t *fifo, uint16_t size, uint8_t  *buffer)
+{
+  uint16_t tail = fifo->tail;
+  uint16_t head = fifo->head;
+  uint16_t size_aligned = FIFO_ALIGN(size, FIFO_ALIGNMENT);
+
+  if (FIFO_SPSC_SIZE(tail, head, fifo->max_size) >= size_aligned) {
+    /* Do not read the storage before the producer has published it */
+    FIFO_SPSC_BARRIER();
+    Osal_MemCpy(buffer, &fifo->buffer[head], size);
+    FIFO_SPSC_BARRIER();
+    fifo->head = ADVANCE_QUEUE(head, size_aligned, fifo->max_size);
+    return 0;
+  }
+  return 1;
+}
+
+/* Consumer side helper: locate the oldest variable length item without consuming it */
+static uint8_t _fifo_spsc_peek_var_len_item(circular_fifo_spsc_t *fifo, uint16_t head, uint16_t *size, uint16_t *index, uint16_t *total_aligned)
+{
+  uint16_t tail = fifo->tail;
+  uint16_t available = FIFO_SPSC_SIZE(tail, head, fifo->max_size);
+  uint8_t  length_size_aligned = FIFO_ALIGN(VAR_LEN_ITEM_SIZE_LENGTH, FIFO_ALIGNMENT);
+
+  if (available < length_size_aligned) {
+    return 1;
+  }
+  FIFO_SPSC_BARRIER();
+  Osal_MemCpy(size, &fifo->buffer[head], VAR_LEN_ITEM_SIZE_LENGTH);
+  *total_aligned = length_size_aligned + FIFO_ALIGN(*size, FIFO_ALIGNMENT);
+  if (available < *total_aligned) {
+    return 1;
+  }
+  /* Item payload is never wrapped, see fifo_get_no_wrap() */
+  *index = ADVANCE_QUEUE(head, length_size_aligned, fifo->max_size);
+  if (*index == 0) {
+    *index = fifo->max_size;
+  }
+  return 0;
+}
+
+/**
+* @brief  Get the oldest variable length item from the SPSC fifo. Consumer side only.
+* @retval 0 on success, 1 if the fifo is empty
+*/
+uint8_t fifo_spsc_get_var_len_item(circular_fifo_spsc_t *fifo, uint16_t *size, uint8_t  *buffer)
+{
+  uint16_t head = fifo->head;
+  uint16_t index, total_aligned;
+
+  if (_fifo_spsc_peek_var_len_item(fifo, head, size, &index, &total_aligned) != 0) {
+    return 1;
+  }
+  Osal_MemCpy(buffer, &fifo->buffer[index], *size);
+  FIFO_SPSC_BARRIER();
+  fifo->head = ADVANCE_QUEUE(head, total_aligned, fifo->max_size);
+  return 0;
+}
+
+/**
+* @brief  Drop the oldest variable length item from the SPSC fifo. Consumer side only.
+* @retval 0 on success, 1 if the fifo is empty
+*/
+uint8_t fifo_spsc_discard_var_len_item(circular_fifo_spsc_t *fifo)
+{
+  uint16_t head = fifo->head;
+  uint16_t size, index, total_aligned;
+
+  if (_fifo_spsc_peek_var_len_item(fifo, head, &size, &index, &total_aligned) != 0) {
+    return 1;
+  }
+  FIFO_SPSC_BARRIER();
+  fifo->head = ADVANCE_QUEUE(head, total_aligned, fifo->max_size);
+  return 0;
+}
@@ -19,9 +19,94 @@
 ******************************************************************************
 */ 
 /* Includes ------------------------------------------------------------------*/
-#include <string.h>
+#include <stdint.h>
 #include "osal.h"
- 
+
+/* Word accesses below alias buffers of any type. The core does not support
+ * unaligned word accesses, so they are only done on 4-byte aligned addresses. */
+#if defined(__GNUC__)
+typedef uint32_t __attribute__((__may_alias__)) osal_word_t;
+#else
+typedef uint32_t osal_word_t;
+#endif
+
+#define OSAL_WORD_MASK  (3U)
+#define OSAL_IS_ALIGNED(p) ((((uintptr_t)(p)) & OSAL_WORD_MASK) == 0U)
+
+#ifndef CONFIG_BLUENRG_LP_OSAL_MEMCPY_ASM
+/**
+ * Osal_MemCpy
+ * Portable version of osal_memcpy.s. When source and destination share the
+ * same alignment the copy is done 4 words at a time, otherwise the destination
+ * is aligned and the source words are merged with shifts (little endian).
+ */
+void Osal_MemCpy(void *dest, const void *src, unsigned int size)
+{
+  uint8_t *d = (uint8_t *)dest;
+  const uint8_t *s = (const uint8_t *)src;
+
+  if (((((uintptr_t)d) ^ ((uintptr_t)s)) & OSAL_WORD_MASK) == 0U) {
+    osal_word_t *dw;
+    const osal_word_t *sw;
+
+    while ((size != 0U) && !OSAL_IS_ALIGNED(s)) {
+      *d++ = *s++;
+      size--;
+    }
+    dw = (osal_word_t *)d;
+    sw = (const osal_word_t *)s;
+    while (size >= 16U) {
+      dw[0] = sw[0];
+      dw[1] = sw[1];
+      dw[2] = sw[2];
+      dw[3] = sw[3];
+      dw += 4;
+      sw += 4;
+      size -= 16U;
+    }
+    while (size >= 4U) {
+      *dw++ = *sw++;
+      size -= 4U;
+    }
+    d = (uint8_t *)dw;
+    s = (const uint8_t *)sw;
+  }
+  else if (size >= 8U) {
+    osal_word_t *dw;
+    const osal_word_t *sw;
+    uint32_t shift, prev, next, i;
+
+    while (!OSAL_IS_ALIGNED(d)) {
+      *d++ = *s++;
+      size--;
+    }
+    /* Here s is not aligned, so shift is never 0. The source bytes of the
+     * first word are read one by one and a word is only loaded while it lies
+     * entirely in the source, so nothing outside [src, src + size) is read. */
+    shift = (((uintptr_t)s) & OSAL_WORD_MASK) * 8U;
+    sw = (const osal_word_t *)((((uintptr_t)s) & ~((uintptr_t)OSAL_WORD_MASK)) + 4U);
+    dw = (osal_word_t *)d;
+    prev = 0U;
+    for (i = shift; i < 32U; i += 8U) {
+      prev |= ((uint32_t)s[(i - shift) / 8U]) << i;
+    }
+    while (size >= 8U) {
+      next = *sw++;
+      *dw++ = (prev >> shift) | (next << (32U - shift));
+      prev = next;
+      s += 4;
+      size -= 4U;
+    }
+    d = (uint8_t *)dw;
+  }
+
+  while (size != 0U) {
+    *d++ = *s++;
+    size--;
+  }
+}
+#endif /* CONFIG_BLUENRG_LP_OSAL_MEMCPY_ASM */
+
 /**
  * Osal_MemSet
  * 
@@ -29,15 +114,70 @@
  
 void Osal_MemSet(void *ptr, int value,unsigned int size)
 {
-    memset(ptr,value,size);
+  uint8_t *d = (uint8_t *)ptr;
+  uint32_t pattern = (uint8_t)value;
+
+  while ((size != 0U) && !OSAL_IS_ALIGNED(d)) {
+    *d++ = (uint8_t)pattern;
+    size--;
+  }
+  if (size >= 4U) {
+    osal_word_t *dw = (osal_word_t *)d;
+
+    pattern |= pattern << 8;
+    pattern |= pattern << 16;
+    while (size >= 16U) {
+      dw[0] = pattern;
+      dw[1] = pattern;
+      dw[2] = pattern;
+      dw[3] = pattern;
+      dw += 4;
+      size -= 16U;
+    }
+    while (size >= 4U) {
+      *dw++ = pattern;
+      size -= 4U;
+    }
+    d = (uint8_t *)dw;
+  }
+  while (size != 0U) {
+    *d++ = (uint8_t)pattern;
+    size--;
+  }
 }
 
 /**
  * Osal_MemCmp
- * 
+ * Word compare when both buffers share the same alignment, the first
+ * differing word is then resolved byte by byte to return memcmp() semantic.
  */
 int Osal_MemCmp(void *s1,void *s2,unsigned int size)
 {
-    return(memcmp(s1,s2,size));
-}
+  const uint8_t *p1 = (const uint8_t *)s1;
+  const uint8_t *p2 = (const uint8_t *)s2;
 
+  if (((((uintptr_t)p1) ^ ((uintptr_t)p2)) & OSAL_WORD_MASK) == 0U) {
+    while ((size != 0U) && !OSAL_IS_ALIGNED(p1)) {
+      if (*p1 != *p2) {
+        return (int)*p1 - (int)*p2;
+      }
+      p1++;
+      p2++;
+      size--;
+    }
+    while ((size >= 4U) && (*(const osal_word_t *)p1 == *(const osal_word_t *)p2)) {
+      p1 += 4;
+      p2 += 4;
+      size -= 4U;
+    }
+  }
+  while (size != 0U) {
+    if (*p1 != *p2) {
+      return (int)*p1 - (int)*p2;
+    }
+    p1++;
+    p2++;
+    size--;
+  }
+  return 0;
+}
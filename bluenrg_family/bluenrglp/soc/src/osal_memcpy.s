@@ -1,4 +1,4 @@
-#include "../inc/asm.h"
+#include "asm.h"
 
                 __CODE__
                 __THUMB__